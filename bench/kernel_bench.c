@@ -0,0 +1,656 @@
+/*
+  +------------------------------------------------------------------------+
+  | Kernel microbenchmarks                                                 |
+  +------------------------------------------------------------------------+
+  | Embeds PHP through the embed SAPI with the extension linked in and     |
+  | measures the kernel primitives one by one. Every case prints a JSON    |
+  | line with its name, the iterations, ns/op and allocations/op.          |
+  |                                                                        |
+  | Allocations are counted in a forked child running with the Zend memory |
+  | manager replaced by counting malloc handlers (USE_ZEND_ALLOC=0); the   |
+  | timings come from the parent running with the regular Zend allocator.  |
+  +------------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <sapi/embed/php_embed.h>
+
+#include "php_ext.h"
+
+#include "kernel/main.h"
+#include "kernel/memory.h"
+#include "kernel/array.h"
+#include "kernel/concat.h"
+#include "kernel/fcall.h"
+#include "kernel/object.h"
+#include "kernel/operators.h"
+#include "kernel/string.h"
+#include "kernel/filter.h"
+
+extern zend_module_entry yii_module_entry;
+
+#define BENCH_DEFAULT_ITERATIONS 1000000
+#define BENCH_DEFAULT_REPEATS    5
+
+typedef struct _bench_state {
+	long iterations;
+	unsigned long allocs;
+	struct timespec started;
+	double ns;
+	unsigned long measured_allocs;
+} bench_state;
+
+typedef void (*bench_func)(bench_state *st TSRMLS_DC);
+
+typedef struct _bench_case {
+	const char *name;
+	bench_func func;
+} bench_case;
+
+static bench_state bench;
+
+/*
+ * Allocation counting
+ *--------------------
+ */
+
+static void *bench_malloc(size_t size)
+{
+	++bench.allocs;
+	return malloc(size);
+}
+
+static void *bench_realloc(void *ptr, size_t size)
+{
+	++bench.allocs;
+	return realloc(ptr, size);
+}
+
+static void bench_free(void *ptr)
+{
+	free(ptr);
+}
+
+static int bench_install_counters(TSRMLS_D)
+{
+#if PHP_VERSION_ID >= 50400
+	zend_mm_heap *heap = zend_mm_set_heap(NULL TSRMLS_CC);
+
+	zend_mm_set_heap(heap TSRMLS_CC);
+	zend_mm_set_custom_handlers(heap, bench_malloc, bench_free, bench_realloc);
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+/*
+ * Timing
+ *-------
+ */
+
+static inline void bench_start(bench_state *st)
+{
+	st->allocs = 0;
+	clock_gettime(CLOCK_MONOTONIC, &st->started);
+}
+
+static inline void bench_stop(bench_state *st)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	st->measured_allocs = st->allocs;
+	st->ns = (double) (now.tv_sec - st->started.tv_sec) * 1e9 + (double) (now.tv_nsec - st->started.tv_nsec);
+}
+
+/*
+ * Fixtures
+ *---------
+ */
+
+static zval *bench_string(const char *str)
+{
+	zval *zv;
+
+	MAKE_STD_ZVAL(zv);
+	ZVAL_STRING(zv, str, 1);
+	return zv;
+}
+
+static zval *bench_object(TSRMLS_D)
+{
+	zval *object;
+	zend_class_entry **ce;
+
+	if (zend_lookup_class(SL("BenchTarget"), &ce TSRMLS_CC) == FAILURE) {
+		zend_eval_string(
+			"class BenchTarget {"
+			"  public $value = 'bench';"
+			"  public function run($a) { return $a; }"
+			"}", NULL, "kernel_bench" TSRMLS_CC);
+		zend_lookup_class(SL("BenchTarget"), &ce TSRMLS_CC);
+	}
+
+	MAKE_STD_ZVAL(object);
+	object_init_ex(object, *ce);
+	return object;
+}
+
+static zval *bench_array(long size)
+{
+	zval *arr, *value;
+	char key[32];
+	long i;
+
+	MAKE_STD_ZVAL(arr);
+	array_init_size(arr, size);
+	for (i = 0; i < size; ++i) {
+		MAKE_STD_ZVAL(value);
+		ZVAL_LONG(value, i);
+		snprintf(key, sizeof(key), "key%ld", i);
+		add_assoc_zval(arr, key, value);
+		Z_ADDREF_P(value);
+		add_index_zval(arr, i, value);
+	}
+
+	return arr;
+}
+
+/*
+ * Cases
+ *------
+ */
+
+static void bench_concat_sv(bench_state *st TSRMLS_DC)
+{
+	zval *result = NULL, *value = bench_string("value");
+	long i;
+
+	ZEPHIR_MM_GROW();
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		ZEPHIR_INIT_NVAR(result);
+		ZEPHIR_CONCAT_SV(result, "prefix:", value);
+	}
+	bench_stop(st);
+
+	ZEPHIR_MM_RESTORE();
+	zval_ptr_dtor(&value);
+}
+
+static void bench_concat_svs(bench_state *st TSRMLS_DC)
+{
+	zval *result = NULL, *value = bench_string("value");
+	long i;
+
+	ZEPHIR_MM_GROW();
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		ZEPHIR_INIT_NVAR(result);
+		ZEPHIR_CONCAT_SVS(result, "{", value, "}");
+	}
+	bench_stop(st);
+
+	ZEPHIR_MM_RESTORE();
+	zval_ptr_dtor(&value);
+}
+
+static void bench_concat_vv(bench_state *st TSRMLS_DC)
+{
+	zval *result = NULL, *left = bench_string("left"), *right;
+	long i;
+
+	MAKE_STD_ZVAL(right);
+	ZVAL_LONG(right, 12345);
+
+	ZEPHIR_MM_GROW();
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		ZEPHIR_INIT_NVAR(result);
+		ZEPHIR_CONCAT_VV(result, left, right);
+	}
+	bench_stop(st);
+
+	ZEPHIR_MM_RESTORE();
+	zval_ptr_dtor(&left);
+	zval_ptr_dtor(&right);
+}
+
+static void bench_concat_n(bench_state *st TSRMLS_DC)
+{
+	zval *result = NULL, *name = bench_string("name"), *value = bench_string("value");
+	long i;
+
+	ZEPHIR_MM_GROW();
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		ZEPHIR_INIT_NVAR(result);
+		ZEPHIR_CONCAT_N(result, 0, ZEPHIR_CONCAT_OP_S("<"), ZEPHIR_CONCAT_OP_V(name), ZEPHIR_CONCAT_OP_S(">"), ZEPHIR_CONCAT_OP_V(value), ZEPHIR_CONCAT_OP_S("</>"));
+	}
+	bench_stop(st);
+
+	ZEPHIR_MM_RESTORE();
+	zval_ptr_dtor(&name);
+	zval_ptr_dtor(&value);
+}
+
+static void bench_sconcat_vs(bench_state *st TSRMLS_DC)
+{
+	zval *result = NULL, *value = bench_string("chunk");
+	long i;
+
+	ZEPHIR_MM_GROW();
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		/* Keep the string short so the benchmark measures appends, not copies of a huge buffer */
+		if ((i & 255) == 0) {
+			ZEPHIR_INIT_NVAR(result);
+			ZVAL_EMPTY_STRING(result);
+		}
+		ZEPHIR_SCONCAT_VS(result, value, ";");
+	}
+	bench_stop(st);
+
+	ZEPHIR_MM_RESTORE();
+	zval_ptr_dtor(&value);
+}
+
+static void bench_array_update_string(bench_state *st TSRMLS_DC)
+{
+	zval *arr = bench_array(16), *value;
+	long i;
+
+	MAKE_STD_ZVAL(value);
+	ZVAL_LONG(value, 1);
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		zephir_array_update_string(&arr, SL("key7"), &value, PH_COPY | PH_SEPARATE);
+	}
+	bench_stop(st);
+
+	zval_ptr_dtor(&arr);
+	zval_ptr_dtor(&value);
+}
+
+static void bench_array_update_long(bench_state *st TSRMLS_DC)
+{
+	zval *arr = bench_array(16), *value;
+	long i;
+
+	MAKE_STD_ZVAL(value);
+	ZVAL_LONG(value, 1);
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		zephir_array_update_long(&arr, 7, &value, PH_COPY | PH_SEPARATE, __FILE__, __LINE__);
+	}
+	bench_stop(st);
+
+	zval_ptr_dtor(&arr);
+	zval_ptr_dtor(&value);
+}
+
+static void bench_array_update_zval(bench_state *st TSRMLS_DC)
+{
+	zval *arr = bench_array(16), *key = bench_string("key7"), *value;
+	long i;
+
+	MAKE_STD_ZVAL(value);
+	ZVAL_LONG(value, 1);
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		zephir_array_update_zval(&arr, key, &value, PH_COPY | PH_SEPARATE);
+	}
+	bench_stop(st);
+
+	zval_ptr_dtor(&arr);
+	zval_ptr_dtor(&key);
+	zval_ptr_dtor(&value);
+}
+
+static void bench_array_fetch_string(bench_state *st TSRMLS_DC)
+{
+	zval *arr = bench_array(16), *fetched;
+	long i;
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		zephir_array_fetch_string(&fetched, arr, SL("key7"), PH_NOISY | PH_READONLY TSRMLS_CC);
+	}
+	bench_stop(st);
+
+	zval_ptr_dtor(&arr);
+}
+
+static void bench_array_fetch_long(bench_state *st TSRMLS_DC)
+{
+	zval *arr = bench_array(16), *fetched;
+	long i;
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		zephir_array_fetch_long(&fetched, arr, 7, PH_NOISY | PH_READONLY TSRMLS_CC);
+	}
+	bench_stop(st);
+
+	zval_ptr_dtor(&arr);
+}
+
+static void bench_array_fetch_zval(bench_state *st TSRMLS_DC)
+{
+	zval *arr = bench_array(16), *key = bench_string("key7"), *fetched;
+	long i;
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		zephir_array_fetch(&fetched, arr, key, PH_NOISY TSRMLS_CC);
+		zval_ptr_dtor(&fetched);
+	}
+	bench_stop(st);
+
+	zval_ptr_dtor(&arr);
+	zval_ptr_dtor(&key);
+}
+
+static void bench_call_method(bench_state *st, zephir_fcall_cache_entry **cache TSRMLS_DC)
+{
+	zval *object = bench_object(TSRMLS_C), *argument, *retval;
+	zval *params[1];
+	long i;
+
+	MAKE_STD_ZVAL(argument);
+	ZVAL_LONG(argument, 1);
+	params[0] = argument;
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		retval = NULL;
+		zephir_call_class_method_aparams(&retval, Z_OBJCE_P(object), zephir_fcall_method, object, SL("run"), cache, 1, params TSRMLS_CC);
+		if (retval) {
+			zval_ptr_dtor(&retval);
+		}
+	}
+	bench_stop(st);
+
+	zval_ptr_dtor(&argument);
+	zval_ptr_dtor(&object);
+}
+
+static void bench_call_class_method_aparams(bench_state *st TSRMLS_DC)
+{
+	bench_call_method(st, NULL TSRMLS_CC);
+}
+
+static void bench_call_class_method_aparams_cached(bench_state *st TSRMLS_DC)
+{
+	zephir_fcall_cache_entry *cache = NULL;
+
+	bench_call_method(st, &cache TSRMLS_CC);
+}
+
+static void bench_read_property(bench_state *st TSRMLS_DC)
+{
+	zval *object = bench_object(TSRMLS_C), *value;
+	long i;
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		zephir_read_property(&value, object, SL("value"), PH_NOISY_CC);
+		zval_ptr_dtor(&value);
+	}
+	bench_stop(st);
+
+	zval_ptr_dtor(&object);
+}
+
+static void bench_fast_strpos(bench_state *st TSRMLS_DC)
+{
+	zval *haystack, *needle = bench_string("needle"), result;
+	char *buf;
+	long i;
+
+	/* 4 KiB of text with the needle at the very end */
+	buf = emalloc(4096 + 7);
+	memset(buf, 'x', 4096);
+	memcpy(buf + 4096, "needle", 7);
+
+	MAKE_STD_ZVAL(haystack);
+	ZVAL_STRINGL(haystack, buf, 4096 + 6, 0);
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		zephir_fast_strpos(&result, haystack, needle, 0);
+	}
+	bench_stop(st);
+
+	zval_ptr_dtor(&haystack);
+	zval_ptr_dtor(&needle);
+}
+
+static void bench_escape(bench_state *st, const char *str TSRMLS_DC)
+{
+	zval *value = bench_string(str), *quote_style, *charset, result;
+	long i;
+
+	MAKE_STD_ZVAL(quote_style);
+	ZVAL_LONG(quote_style, ENT_QUOTES);
+	MAKE_STD_ZVAL(charset);
+	ZVAL_NULL(charset);
+
+	bench_start(st);
+	for (i = 0; i < st->iterations; ++i) {
+		zephir_escape_html(&result, value, quote_style, charset TSRMLS_CC);
+		zval_dtor(&result);
+	}
+	bench_stop(st);
+
+	zval_ptr_dtor(&value);
+	zval_ptr_dtor(&quote_style);
+	zval_ptr_dtor(&charset);
+}
+
+static void bench_escape_html_safe(bench_state *st TSRMLS_DC)
+{
+	bench_escape(st, "Plain text without any character that needs escaping, 1234567890" TSRMLS_CC);
+}
+
+static void bench_escape_html(bench_state *st TSRMLS_DC)
+{
+	bench_escape(st, "<a href=\"/path?a=1&b=2\">Tom & Jerry's</a>" TSRMLS_CC);
+}
+
+static const bench_case bench_cases[] = {
+	{ "concat_sv",                          bench_concat_sv },
+	{ "concat_svs",                         bench_concat_svs },
+	{ "concat_vv",                          bench_concat_vv },
+	{ "concat_n",                           bench_concat_n },
+	{ "sconcat_vs",                         bench_sconcat_vs },
+	{ "array_update_string",                bench_array_update_string },
+	{ "array_update_long",                  bench_array_update_long },
+	{ "array_update_zval",                  bench_array_update_zval },
+	{ "array_fetch_string",                 bench_array_fetch_string },
+	{ "array_fetch_long",                   bench_array_fetch_long },
+	{ "array_fetch",                        bench_array_fetch_zval },
+	{ "call_class_method_aparams",          bench_call_class_method_aparams },
+	{ "call_class_method_aparams_cached",   bench_call_class_method_aparams_cached },
+	{ "read_property",                      bench_read_property },
+	{ "fast_strpos",                        bench_fast_strpos },
+	{ "escape_html_safe",                   bench_escape_html_safe },
+	{ "escape_html",                        bench_escape_html },
+	{ NULL, NULL }
+};
+
+/*
+ * Driver
+ *-------
+ */
+
+/**
+ * Starts the embedded engine with the extension registered as a built-in module
+ */
+static int bench_embed_startup(sapi_module_struct *sapi_module)
+{
+	return php_module_startup(sapi_module, &yii_module_entry, 1);
+}
+
+static int bench_selected(const bench_case *c, const char *filter)
+{
+	return !filter || strstr(c->name, filter) != NULL;
+}
+
+/**
+ * Runs the selected cases, keeping the best time of every case and the allocations of its last run
+ */
+static void bench_run_suite(const char *filter, long iterations, int repeats, int counting, double *ns, double *allocs)
+{
+	const bench_case *c;
+	char *argv[2] = { "kernel_bench", NULL };
+	size_t n;
+	int r;
+
+	php_embed_module.startup = bench_embed_startup;
+
+	PHP_EMBED_START_BLOCK(1, argv)
+
+		if (counting && !bench_install_counters(TSRMLS_C)) {
+			counting = 0;
+		}
+
+		for (c = bench_cases, n = 0; c->name; ++c, ++n) {
+			ns[n] = -1;
+			allocs[n] = -1;
+			if (!bench_selected(c, filter)) {
+				continue;
+			}
+
+			/* Warm up the caches before measuring */
+			bench.iterations = iterations / 10 + 1;
+			c->func(&bench TSRMLS_CC);
+			bench.iterations = iterations;
+
+			for (r = 0; r < repeats; ++r) {
+				c->func(&bench TSRMLS_CC);
+				if (ns[n] < 0 || bench.ns < ns[n]) {
+					ns[n] = bench.ns;
+				}
+			}
+
+			if (counting) {
+				allocs[n] = (double) bench.measured_allocs / (double) iterations;
+			}
+			ns[n] /= (double) iterations;
+		}
+
+	PHP_EMBED_END_BLOCK()
+}
+
+static void bench_usage(const char *program)
+{
+	fprintf(stderr, "Usage: %s [-n iterations] [-r repeats] [-f filter] [-l]\n", program);
+}
+
+int main(int argc, char *argv[])
+{
+	const bench_case *c;
+	const char *filter = NULL;
+	long iterations = BENCH_DEFAULT_ITERATIONS;
+	int repeats = BENCH_DEFAULT_REPEATS, opt, fds[2], status;
+	size_t n, count = sizeof(bench_cases) / sizeof(bench_case) - 1;
+	double ns[sizeof(bench_cases) / sizeof(bench_case)], allocs[sizeof(bench_cases) / sizeof(bench_case)];
+	double unused[sizeof(bench_cases) / sizeof(bench_case)];
+	pid_t pid;
+
+	while ((opt = getopt(argc, argv, "n:r:f:lh")) != -1) {
+		switch (opt) {
+			case 'n':
+				iterations = atol(optarg);
+				break;
+			case 'r':
+				repeats = atoi(optarg);
+				break;
+			case 'f':
+				filter = optarg;
+				break;
+			case 'l':
+				for (c = bench_cases; c->name; ++c) {
+					printf("%s\n", c->name);
+				}
+				return 0;
+			default:
+				bench_usage(argv[0]);
+				return opt == 'h' ? 0 : 1;
+		}
+	}
+
+	if (iterations <= 0 || repeats <= 0) {
+		bench_usage(argv[0]);
+		return 1;
+	}
+
+	/* Allocations are counted in a child using the system allocator, the parent keeps the Zend allocator for timings */
+	if (pipe(fds) != 0) {
+		perror("pipe");
+		return 1;
+	}
+
+	pid = fork();
+	if (pid < 0) {
+		perror("fork");
+		return 1;
+	}
+
+	if (pid == 0) {
+		close(fds[0]);
+		setenv("USE_ZEND_ALLOC", "0", 1);
+		bench_run_suite(filter, iterations, 1, 1, ns, allocs);
+		if (write(fds[1], allocs, sizeof(double) * count) != (ssize_t) (sizeof(double) * count)) {
+			_exit(1);
+		}
+		_exit(0);
+	}
+
+	close(fds[1]);
+	if (read(fds[0], allocs, sizeof(double) * count) != (ssize_t) (sizeof(double) * count)) {
+		for (n = 0; n < count; ++n) {
+			allocs[n] = -1;
+		}
+	}
+	close(fds[0]);
+	waitpid(pid, &status, 0);
+
+	bench_run_suite(filter, iterations, repeats, 0, ns, unused);
+
+	for (c = bench_cases, n = 0; c->name; ++c, ++n) {
+		if (!bench_selected(c, filter)) {
+			continue;
+		}
+
+		printf("{\"name\":\"%s\",\"iterations\":%ld,\"ns_per_op\":%.3f,", c->name, iterations, ns[n]);
+		if (allocs[n] < 0) {
+			printf("\"allocs_per_op\":null}\n");
+		} else {
+			printf("\"allocs_per_op\":%.3f}\n", allocs[n]);
+		}
+	}
+
+	return 0;
+}
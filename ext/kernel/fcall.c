@@ -32,6 +32,9 @@
 #include "kernel/exception.h"
 #include "kernel/backtrace.h"
 
+/** Keys shorter than this are built on the stack */
+#define ZEPHIR_FCALL_KEY_STACK_SIZE 128
+
 #if PHP_VERSION_ID >= 50500
 static const unsigned char tolower_map[256] = {
 	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
@@ -102,7 +105,10 @@ static inline ulong zephir_update_hash(const char *arKey, uint nKeyLength, ulong
 }
 #endif
 
-static ulong zephir_make_fcall_key(char **result, size_t *length, const zend_class_entry *obj_ce, zephir_call_type type, zval *function_name TSRMLS_DC)
+/**
+ * Builds the fcache key; short keys are written into @a stack_buf instead of being allocated
+ */
+static ulong zephir_make_fcall_key(char **result, size_t *length, char *stack_buf, size_t stack_size, const zend_class_entry *obj_ce, zephir_call_type type, zval *function_name TSRMLS_DC)
 {
 	const zend_class_entry *calling_scope = EG(scope);
 	char *buf = NULL, *c;
@@ -140,7 +146,7 @@ static ulong zephir_make_fcall_key(char **result, size_t *length, const zend_cla
 		l   = (size_t)(Z_STRLEN_P(function_name)) + 1;
 		c   = Z_STRVAL_P(function_name);
 		len = 2 * ppzce_size + l;
-		buf = ecalloc(1, len);
+		buf = (len <= stack_size) ? stack_buf : emalloc(len);
 
 		memcpy(buf,                  c,               l);
 		memcpy(buf + l,              &calling_scope,  ppzce_size);
@@ -157,7 +163,7 @@ static ulong zephir_make_fcall_key(char **result, size_t *length, const zend_cla
 			l   = (size_t)(Z_STRLEN_PP(method)) + 1;
 			c   = Z_STRVAL_PP(method);
 			len = 2 * ppzce_size + l;
-			buf = ecalloc(1, len);
+			buf = (len <= stack_size) ? stack_buf : emalloc(len);
 
 			memcpy(buf,                  c,               l);
 			memcpy(buf + l,              &calling_scope,  ppzce_size);
@@ -168,7 +174,7 @@ static ulong zephir_make_fcall_key(char **result, size_t *length, const zend_cla
 		if (Z_OBJ_HANDLER_P(function_name, get_closure)) {
 			l   = sizeof("__invoke");
 			len = 2 * ppzce_size + l;
-			buf = ecalloc(1, len);
+			buf = (len <= stack_size) ? stack_buf : emalloc(len);
 
 			memcpy(buf,                  "__invoke",     l);
 			memcpy(buf + l,              &calling_scope, ppzce_size);
@@ -201,6 +207,28 @@ static ulong zephir_make_fcall_key(char **result, size_t *length, const zend_cla
 	return hash;
 }
 
+/**
+ * Checks that a resolved handler is the method stored in the function table.
+ * Trampolines created for __call/__callStatic and handlers returned by get_method
+ * are released after the call and must never be cached
+ */
+static int zephir_fcall_is_cacheable(const zend_fcall_info_cache *fcic, const char *lcname TSRMLS_DC)
+{
+	HashTable *function_table;
+	zend_function *func;
+
+	if (!fcic->function_handler) {
+		return 0;
+	}
+
+	function_table = fcic->calling_scope ? &fcic->calling_scope->function_table : EG(function_table);
+	if (zend_hash_find(function_table, lcname, strlen(lcname) + 1, (void**)&func) == FAILURE) {
+		return 0;
+	}
+
+	return func == fcic->function_handler;
+}
+
 ZEPHIR_ATTR_NONNULL static void zephir_fcall_populate_fci_cache(zend_fcall_info_cache *fcic, zend_fcall_info *fci, zephir_call_type type TSRMLS_DC)
 {
 	switch (type) {
@@ -286,6 +314,106 @@ ZEPHIR_ATTR_NONNULL static void zephir_fcall_populate_fci_cache(zend_fcall_info_
 
 }
 
+/**
+ * Module-lifetime cache for calls that resolve to internal functions of internal classes.
+ * These targets are added as requests resolve them and survive between requests,
+ * the table is released at module shutdown by zephir_kernel_shutdown()
+ */
+#ifndef ZTS
+static HashTable *zephir_fcache_persistent = NULL;
+
+#ifndef ZEPHIR_RELEASE
+static void zephir_fcache_persistent_dtor(void *pData)
+{
+	free(*(zephir_fcall_cache_entry**)pData);
+}
+#endif
+#endif
+
+/**
+ * Checks whether every class referenced by an fcache key outlives the request
+ */
+static int zephir_fcall_key_is_internal(const char *key)
+{
+	zend_class_entry *calling_scope, *obj_ce;
+	size_t l = strlen(key) + 1;
+
+	memcpy(&calling_scope, key + l, sizeof(zend_class_entry*));
+	memcpy(&obj_ce, key + l + sizeof(zend_class_entry*), sizeof(zend_class_entry*));
+
+	return (!calling_scope || calling_scope->type == ZEND_INTERNAL_CLASS) && (!obj_ce || obj_ce->type == ZEND_INTERNAL_CLASS);
+}
+
+/**
+ * Looks up a key in the persistent fcache
+ */
+static int zephir_fcache_persistent_find(const char *key, size_t key_len, ulong hash, zephir_fcall_cache_entry ***entry)
+{
+#ifndef ZTS
+	if (zephir_fcache_persistent) {
+		return zend_hash_quick_find(zephir_fcache_persistent, key, key_len, hash, (void**)entry);
+	}
+#endif
+
+	return FAILURE;
+}
+
+/**
+ * Stores a resolved internal function in the persistent fcache
+ */
+static int zephir_fcache_persistent_add(const char *key, size_t key_len, ulong hash, zend_function *func)
+{
+#ifndef ZTS
+	zephir_fcall_cache_entry *entry;
+
+	if (func->type != ZEND_INTERNAL_FUNCTION || !zephir_fcall_key_is_internal(key)) {
+		return FAILURE;
+	}
+
+	if (!zephir_fcache_persistent) {
+		zephir_fcache_persistent = pemalloc(sizeof(HashTable), 1);
+#ifndef ZEPHIR_RELEASE
+		zend_hash_init(zephir_fcache_persistent, 64, NULL, zephir_fcache_persistent_dtor, 1);
+#else
+		zend_hash_init(zephir_fcache_persistent, 64, NULL, NULL, 1);
+#endif
+	}
+
+#ifndef ZEPHIR_RELEASE
+	entry = malloc(sizeof(zephir_fcall_cache_entry));
+	entry->f     = func;
+	entry->times = 0;
+#else
+	entry = func;
+#endif
+
+	if (zend_hash_quick_add(zephir_fcache_persistent, key, key_len, hash, &entry, sizeof(zephir_fcall_cache_entry*), NULL) == FAILURE) {
+#ifndef ZEPHIR_RELEASE
+		free(entry);
+#endif
+		return FAILURE;
+	}
+
+	return SUCCESS;
+#else
+	return FAILURE;
+#endif
+}
+
+/**
+ * Releases the persistent fcache, called at module shutdown through zephir_kernel_shutdown()
+ */
+void zephir_fcall_cache_shutdown(void)
+{
+#ifndef ZTS
+	if (zephir_fcache_persistent) {
+		zend_hash_destroy(zephir_fcache_persistent);
+		pefree(zephir_fcache_persistent, 1);
+		zephir_fcache_persistent = NULL;
+	}
+#endif
+}
+
 /**
  * Calls a function/method in the PHP userland
  */
@@ -301,6 +429,7 @@ int zephir_call_user_function(zval **object_pp, zend_class_entry *obj_ce, zephir
 	zend_fcall_info_cache fcic /* , clone */;
 	zend_zephir_globals_def *zephir_globals_ptr = ZEPHIR_VGLOBAL;
 	char *fcall_key = NULL;
+	char fcall_key_buf[ZEPHIR_FCALL_KEY_STACK_SIZE];
 	size_t fcall_key_len;
 	ulong fcall_key_hash;
 	zephir_fcall_cache_entry **temp_cache_entry = NULL;
@@ -352,7 +481,7 @@ int zephir_call_user_function(zval **object_pp, zend_class_entry *obj_ce, zephir
 	}
 
 	if (!cache_entry || !*cache_entry) {
-		fcall_key_hash = zephir_make_fcall_key(&fcall_key, &fcall_key_len, (object_pp ? Z_OBJCE_PP(object_pp) : obj_ce), type, function_name TSRMLS_CC);
+		fcall_key_hash = zephir_make_fcall_key(&fcall_key, &fcall_key_len, fcall_key_buf, sizeof(fcall_key_buf), (object_pp ? Z_OBJCE_PP(object_pp) : obj_ce), type, function_name TSRMLS_CC);
 	}
 
 	fci.size           = sizeof(fci);
@@ -367,7 +496,10 @@ int zephir_call_user_function(zval **object_pp, zend_class_entry *obj_ce, zephir
 
 	fcic.initialized = 0;
 	if (!cache_entry || !*cache_entry) {
-		if (fcall_key && zend_hash_quick_find(zephir_globals_ptr->fcache, fcall_key, fcall_key_len, fcall_key_hash, (void**)&temp_cache_entry) != FAILURE) {
+		if (fcall_key && (
+			    zephir_fcache_persistent_find(fcall_key, fcall_key_len, fcall_key_hash, &temp_cache_entry) != FAILURE
+			 || zend_hash_quick_find(zephir_globals_ptr->fcache, fcall_key, fcall_key_len, fcall_key_hash, (void**)&temp_cache_entry) != FAILURE
+		)) {
 			zephir_fcall_populate_fci_cache(&fcic, &fci, type TSRMLS_CC);
 
 #ifndef ZEPHIR_RELEASE
@@ -376,13 +508,20 @@ int zephir_call_user_function(zval **object_pp, zend_class_entry *obj_ce, zephir
 #else
 			fcic.function_handler = *temp_cache_entry;
 #endif
+			if (cache_entry) {
+				*cache_entry = *temp_cache_entry;
+			}
 			/*memcpy(&clone, &fcic, sizeof(clone));*/
+			ZEPHIR_KERNEL_STAT_INC(fcache_hits);
+		} else {
+			ZEPHIR_KERNEL_STAT_INC(fcache_misses);
 		}
 	} else {
+		ZEPHIR_KERNEL_STAT_INC(fcache_hits);
 		zephir_fcall_populate_fci_cache(&fcic, &fci, type TSRMLS_CC);
 #ifndef ZEPHIR_RELEASE
 		fcic.function_handler = (*cache_entry)->f;
-		++(*temp_cache_entry)->times;
+		++(*cache_entry)->times;
 #else
 		fcic.function_handler = *cache_entry;
 #endif
@@ -421,27 +560,33 @@ int zephir_call_user_function(zval **object_pp, zend_class_entry *obj_ce, zephir
 	EG(scope) = old_scope;
 
 	if (!cache_entry || !*cache_entry) {
-		if (EXPECTED(status != FAILURE) && fcall_key && !temp_cache_entry && fcic.initialized) {
+		if (EXPECTED(status != FAILURE) && fcall_key && !temp_cache_entry && fcic.initialized && zephir_fcall_is_cacheable(&fcic, fcall_key TSRMLS_CC)) {
+			if (zephir_fcache_persistent_add(fcall_key, fcall_key_len, fcall_key_hash, fcic.function_handler) == SUCCESS) {
+				if (cache_entry && zephir_fcache_persistent_find(fcall_key, fcall_key_len, fcall_key_hash, &temp_cache_entry) != FAILURE) {
+					*cache_entry = *temp_cache_entry;
+				}
+			} else {
 	#ifndef ZEPHIR_RELEASE
-			zephir_fcall_cache_entry *temp_cache_entry = malloc(sizeof(zephir_fcall_cache_entry));
-			cache_entry->f     = fcic.function_handler;
-			cache_entry->times = 0;
+				zephir_fcall_cache_entry *temp_cache_entry = malloc(sizeof(zephir_fcall_cache_entry));
+				temp_cache_entry->f     = fcic.function_handler;
+				temp_cache_entry->times = 0;
 	#else
-			zephir_fcall_cache_entry *temp_cache_entry = fcic.function_handler;
+				zephir_fcall_cache_entry *temp_cache_entry = fcic.function_handler;
 	#endif
-			if (FAILURE == zend_hash_quick_add(zephir_globals_ptr->fcache, fcall_key, fcall_key_len, fcall_key_hash, &temp_cache_entry, sizeof(zephir_fcall_cache_entry*), NULL)) {
+				if (FAILURE == zend_hash_quick_add(zephir_globals_ptr->fcache, fcall_key, fcall_key_len, fcall_key_hash, &temp_cache_entry, sizeof(zephir_fcall_cache_entry*), NULL)) {
 	#ifndef ZEPHIR_RELEASE
-				free(temp_cache_entry);
+					free(temp_cache_entry);
 	#endif
-			} else {
-				if (cache_entry) {
-					*cache_entry = temp_cache_entry;
+				} else {
+					if (cache_entry) {
+						*cache_entry = temp_cache_entry;
+					}
 				}
 			}
 		}
 	}
 
-	if (fcall_key) {
+	if (fcall_key && fcall_key != fcall_key_buf) {
 		efree(fcall_key);
 	}
 
@@ -616,6 +761,119 @@ int zephir_call_class_method_aparams(zval **return_value_ptr, zend_class_entry *
 	return status;
 }
 
+/**
+ * Returns the class that decides how a call site is resolved
+ */
+static inline zend_class_entry *zephir_fcall_ic_class(zend_class_entry *ce, zephir_call_type type, zval *object TSRMLS_DC)
+{
+	switch (type) {
+		case zephir_fcall_method:
+			return object ? Z_OBJCE_P(object) : ce;
+
+		case zephir_fcall_ce:
+		case zephir_fcall_parent:
+			return ce;
+
+		case zephir_fcall_static:
+			return EG(This) ? Z_OBJCE_P(EG(This)) : EG(called_scope);
+
+		default:
+			return EG(This) ? Z_OBJCE_P(EG(This)) : EG(scope);
+	}
+}
+
+/**
+ * Calls a method using the inline cache of the call site; a hit neither allocates nor hashes
+ */
+int zephir_call_class_method_ic(zval **return_value_ptr, zend_class_entry *ce, zephir_call_type type, zval *object,
+	const char *method_name, uint method_len,
+	zephir_fcall_inline_cache *ic,
+	uint param_count, zval **params TSRMLS_DC)
+{
+#ifdef ZTS
+	/* Call sites are not static in thread-safe builds */
+	return zephir_call_class_method_aparams(return_value_ptr, ce, type, object, method_name, method_len, NULL, param_count, params TSRMLS_CC);
+#else
+	zephir_fcall_cache_entry *entry = NULL;
+	zend_class_entry *key_ce, *scope, *called_scope;
+	zephir_fcall_ic_entry *e;
+	zend_function *func;
+	int status;
+	size_t i;
+#ifndef ZEPHIR_RELEASE
+	zephir_fcall_cache_entry local;
+#endif
+
+	key_ce = zephir_fcall_ic_class(ce, type, object TSRMLS_CC);
+	if (UNEXPECTED(ic->megamorphic || !key_ce)) {
+		return zephir_call_class_method_aparams(return_value_ptr, ce, type, object, method_name, method_len, NULL, param_count, params TSRMLS_CC);
+	}
+
+	scope        = EG(scope);
+	called_scope = (type == zephir_fcall_self || type == zephir_fcall_static) ? EG(called_scope) : NULL;
+
+	for (i = 0; i < ic->size; ++i) {
+		e = &ic->entries[i];
+		if (e->ce == key_ce && e->scope == scope && e->called_scope == called_scope && (e->epoch == zephir_cache_epoch || e->epoch == ZEPHIR_CACHE_EPOCH_PERSISTENT)) {
+#ifndef ZEPHIR_RELEASE
+			local.f     = e->func;
+			local.times = 0;
+			entry       = &local;
+#else
+			entry = e->func;
+#endif
+			return zephir_call_class_method_aparams(return_value_ptr, ce, type, object, method_name, method_len, &entry, param_count, params TSRMLS_CC);
+		}
+	}
+
+	status = zephir_call_class_method_aparams(return_value_ptr, ce, type, object, method_name, method_len, &entry, param_count, params TSRMLS_CC);
+	if (!entry) {
+		return status;
+	}
+
+#ifndef ZEPHIR_RELEASE
+	func = entry->f;
+#else
+	func = entry;
+#endif
+
+	/* Reuse a slot left by a previous request before growing the site */
+	e = NULL;
+	for (i = 0; i < ic->size; ++i) {
+		if (ic->entries[i].epoch != zephir_cache_epoch && ic->entries[i].epoch != ZEPHIR_CACHE_EPOCH_PERSISTENT) {
+			e = &ic->entries[i];
+			break;
+		}
+	}
+
+	if (!e) {
+		if (ic->size == ZEPHIR_FCALL_IC_SIZE) {
+			ic->megamorphic = 1;
+			return status;
+		}
+		e = &ic->entries[ic->size++];
+	}
+
+	e->ce           = key_ce;
+	e->scope        = scope;
+	e->called_scope = called_scope;
+	e->func         = func;
+	e->epoch        = zephir_cache_epoch;
+
+	/* Internal targets resolved between internal classes stay valid for the module lifetime */
+	if (
+		    func->type == ZEND_INTERNAL_FUNCTION
+		 && key_ce->type == ZEND_INTERNAL_CLASS
+		 && (!scope || scope->type == ZEND_INTERNAL_CLASS)
+		 && (!called_scope || called_scope->type == ZEND_INTERNAL_CLASS)
+	) {
+		e->epoch = ZEPHIR_CACHE_EPOCH_PERSISTENT;
+	}
+
+	return status;
+#endif
+}
+
 /**
  * Replaces call_user_func_array avoiding function lookup
  * This function does not return FAILURE if an exception has ocurred
@@ -670,6 +928,46 @@ int zephir_call_user_func_array_noex(zval *return_value, zval *handler, zval *pa
 	return status;
 }
 
+/**
+ * Calls a method catching the exception it throws, as try/catch would: the exception is cleared and handed
+ * to the caller, which may clean up before throwing it again with zephir_throw_exception().
+ * Returns FAILURE when an exception was caught, result is then null
+ */
+int zephir_call_method_catch(zval **result, zval **exception, zval *object, zval *method, zval *params TSRMLS_DC)
+{
+	zval *handler;
+
+	MAKE_STD_ZVAL(handler);
+	array_init_size(handler, 2);
+	Z_ADDREF_P(object);
+	add_next_index_zval(handler, object);
+	Z_ADDREF_P(method);
+	add_next_index_zval(handler, method);
+
+	MAKE_STD_ZVAL(*result);
+	ZVAL_NULL(*result);
+	MAKE_STD_ZVAL(*exception);
+	ZVAL_NULL(*exception);
+
+	/* A method that cannot be called has already warned, only exceptions are reported */
+	if (zephir_call_user_func_array_noex(*result, handler, params TSRMLS_CC) == FAILURE || !EG(exception)) {
+		zval_ptr_dtor(&handler);
+		return SUCCESS;
+	}
+
+	zval_ptr_dtor(&handler);
+
+	zval_ptr_dtor(exception);
+	*exception = EG(exception);
+	Z_ADDREF_P(*exception);
+	zend_clear_exception(TSRMLS_C);
+
+	zval_dtor(*result);
+	ZVAL_NULL(*result);
+
+	return FAILURE;
+}
+
 #if PHP_VERSION_ID <= 50309
 
 /**
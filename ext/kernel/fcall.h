@@ -49,6 +49,27 @@ typedef zend_function zephir_fcall_cache_entry;
 
 #endif
 
+#define ZEPHIR_FCALL_IC_SIZE 4
+
+/** Resolved target of a call site for a given receiver class and scope */
+typedef struct _zephir_fcall_ic_entry {
+	zend_class_entry *ce;
+	zend_class_entry *scope;
+	zend_class_entry *called_scope;
+	zend_function *func;
+	zend_uint epoch;
+} zephir_fcall_ic_entry;
+
+/** Polymorphic inline cache attached to a call site */
+typedef struct _zephir_fcall_inline_cache {
+	zend_uchar size;
+	zend_uchar megamorphic;
+	zephir_fcall_ic_entry entries[ZEPHIR_FCALL_IC_SIZE];
+} zephir_fcall_inline_cache;
+
+/** Declares the inline cache of the call site where the macro is expanded */
+#define ZEPHIR_FCALL_IC(name) zephir_nts_static zephir_fcall_inline_cache name = { 0 }
+
 /**
  * @addtogroup callfuncs Calling Functions
  * @{
@@ -193,7 +214,9 @@ typedef zend_function zephir_fcall_cache_entry;
 		zval *params_[] = {__VA_ARGS__}; \
 		ZEPHIR_OBSERVE_OR_NULLIFY_PPZV(return_value_ptr); \
 		if (__builtin_constant_p(method)) { \
-			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_aparams(return_value_ptr, Z_OBJCE_P(object), zephir_fcall_method, object, method, sizeof(method)-1, cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
+			ZEPHIR_FCALL_IC(ic_); \
+			(void)(cache); \
+			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_ic(return_value_ptr, Z_OBJCE_P(object), zephir_fcall_method, object, method, sizeof(method)-1, &ic_, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
 		} \
 		else { \
 			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_aparams(return_value_ptr, Z_OBJCE_P(object), zephir_fcall_method, object, method, strlen(method), cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
@@ -215,7 +238,9 @@ typedef zend_function zephir_fcall_cache_entry;
 	do { \
 		zval *params_[] = {__VA_ARGS__}; \
 		if (__builtin_constant_p(method)) { \
-			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method(return_value, return_value_ptr, Z_OBJCE_P(object), zephir_fcall_method, object, method, sizeof(method)-1, cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
+			ZEPHIR_FCALL_IC(ic_); \
+			(void)(cache); \
+			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method_ic(return_value, return_value_ptr, Z_OBJCE_P(object), zephir_fcall_method, object, method, sizeof(method)-1, &ic_, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
 		} \
 		else { \
 			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method(return_value, return_value_ptr, Z_OBJCE_P(object), zephir_fcall_method, object, method, strlen(method), cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
@@ -227,7 +252,9 @@ typedef zend_function zephir_fcall_cache_entry;
 		zval *params_[] = {__VA_ARGS__}; \
 		ZEPHIR_OBSERVE_OR_NULLIFY_PPZV(return_value_ptr); \
 		if (__builtin_constant_p(method)) { \
-			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_aparams(return_value_ptr, THIS_CE, zephir_fcall_method, this_ptr, method, sizeof(method)-1, cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
+			ZEPHIR_FCALL_IC(ic_); \
+			(void)(cache); \
+			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_ic(return_value_ptr, THIS_CE, zephir_fcall_method, this_ptr, method, sizeof(method)-1, &ic_, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
 		} \
 		else { \
 			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_aparams(return_value_ptr, THIS_CE, zephir_fcall_method, this_ptr, method, strlen(method), cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
@@ -250,7 +277,9 @@ typedef zend_function zephir_fcall_cache_entry;
 		zval *params_[] = {__VA_ARGS__}; \
 		ZEPHIR_OBSERVE_OR_NULLIFY_PPZV(return_value_ptr); \
 		if (__builtin_constant_p(method)) { \
-			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_aparams(return_value_ptr, class_entry, zephir_fcall_parent, this_ptr, method, sizeof(method)-1, cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
+			ZEPHIR_FCALL_IC(ic_); \
+			(void)(cache); \
+			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_ic(return_value_ptr, class_entry, zephir_fcall_parent, this_ptr, method, sizeof(method)-1, &ic_, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
 		} \
 		else { \
 			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_aparams(return_value_ptr, class_entry, zephir_fcall_parent, this_ptr, method, strlen(method), cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
@@ -272,7 +301,9 @@ typedef zend_function zephir_fcall_cache_entry;
 	do { \
 		zval *params_[] = {__VA_ARGS__}; \
 		if (__builtin_constant_p(method)) { \
-			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method(return_value, return_value_ptr, class_entry, zephir_fcall_parent, this_ptr, method, sizeof(method)-1, cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
+			ZEPHIR_FCALL_IC(ic_); \
+			(void)(cache); \
+			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method_ic(return_value, return_value_ptr, class_entry, zephir_fcall_parent, this_ptr, method, sizeof(method)-1, &ic_, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
 		} \
 		else { \
 			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method(return_value, return_value_ptr, class_entry, zephir_fcall_parent, this_ptr, method, strlen(method), cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
@@ -295,7 +326,9 @@ typedef zend_function zephir_fcall_cache_entry;
 		zval *params_[] = {__VA_ARGS__}; \
 		ZEPHIR_OBSERVE_OR_NULLIFY_PPZV(return_value_ptr); \
 		if (__builtin_constant_p(method)) { \
-			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_aparams(return_value_ptr, NULL, zephir_fcall_self, NULL, method, sizeof(method)-1, cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
+			ZEPHIR_FCALL_IC(ic_); \
+			(void)(cache); \
+			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_ic(return_value_ptr, NULL, zephir_fcall_self, NULL, method, sizeof(method)-1, &ic_, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
 		} \
 		else { \
 			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_aparams(return_value_ptr, NULL, zephir_fcall_self, NULL, method, strlen(method), cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
@@ -317,7 +350,9 @@ typedef zend_function zephir_fcall_cache_entry;
 	do { \
 		zval *params_[] = {__VA_ARGS__}; \
 		if (__builtin_constant_p(method)) { \
-			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method(return_value, return_value_ptr, NULL, zephir_fcall_self, NULL, method, sizeof(method)-1, cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
+			ZEPHIR_FCALL_IC(ic_); \
+			(void)(cache); \
+			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method_ic(return_value, return_value_ptr, NULL, zephir_fcall_self, NULL, method, sizeof(method)-1, &ic_, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
 		} \
 		else { \
 			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method(return_value, return_value_ptr, NULL, zephir_fcall_self, NULL, method, strlen(method), cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
@@ -340,7 +375,9 @@ typedef zend_function zephir_fcall_cache_entry;
 		zval *params_[] = {__VA_ARGS__}; \
 		ZEPHIR_OBSERVE_OR_NULLIFY_PPZV(return_value_ptr); \
 		if (__builtin_constant_p(method)) { \
-			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_aparams(return_value_ptr, NULL, zephir_fcall_static, NULL, method, sizeof(method)-1, cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
+			ZEPHIR_FCALL_IC(ic_); \
+			(void)(cache); \
+			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_ic(return_value_ptr, NULL, zephir_fcall_static, NULL, method, sizeof(method)-1, &ic_, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
 		} \
 		else { \
 			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_aparams(return_value_ptr, NULL, zephir_fcall_static, NULL, method, strlen(method), cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
@@ -362,7 +399,9 @@ typedef zend_function zephir_fcall_cache_entry;
 	do { \
 		zval *params_[] = {__VA_ARGS__}; \
 		if (__builtin_constant_p(method)) { \
-			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method(return_value, return_value_ptr, NULL, zephir_fcall_static, NULL, method, sizeof(method)-1, cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
+			ZEPHIR_FCALL_IC(ic_); \
+			(void)(cache); \
+			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method_ic(return_value, return_value_ptr, NULL, zephir_fcall_static, NULL, method, sizeof(method)-1, &ic_, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
 		} \
 		else { \
 			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method(return_value, return_value_ptr, NULL, zephir_fcall_static, NULL, method, strlen(method), cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
@@ -385,7 +424,9 @@ typedef zend_function zephir_fcall_cache_entry;
 		zval *params_[] = {__VA_ARGS__}; \
 		ZEPHIR_OBSERVE_OR_NULLIFY_PPZV(return_value_ptr); \
 		if (__builtin_constant_p(method)) { \
-			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_aparams(return_value_ptr, class_entry, zephir_fcall_ce, NULL, method, sizeof(method)-1, cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
+			ZEPHIR_FCALL_IC(ic_); \
+			(void)(cache); \
+			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_ic(return_value_ptr, class_entry, zephir_fcall_ce, NULL, method, sizeof(method)-1, &ic_, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
 		} \
 		else { \
 			ZEPHIR_LAST_CALL_STATUS = zephir_call_class_method_aparams(return_value_ptr, class_entry, zephir_fcall_ce, NULL, method, strlen(method), cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
@@ -407,7 +448,9 @@ typedef zend_function zephir_fcall_cache_entry;
 	do { \
 		zval *params_[] = {__VA_ARGS__}; \
 		if (__builtin_constant_p(method)) { \
-			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method(return_value, return_value_ptr, class_entry, zephir_fcall_ce, NULL, method, sizeof(method)-1, cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
+			ZEPHIR_FCALL_IC(ic_); \
+			(void)(cache); \
+			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method_ic(return_value, return_value_ptr, class_entry, zephir_fcall_ce, NULL, method, sizeof(method)-1, &ic_, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
 		} \
 		else { \
 			ZEPHIR_LAST_CALL_STATUS = zephir_return_call_class_method(return_value, return_value_ptr, class_entry, zephir_fcall_ce, NULL, method, strlen(method), cache, sizeof(params_)/sizeof(zval*), params_ TSRMLS_CC); \
@@ -513,6 +556,13 @@ int zephir_call_class_method_aparams(zval **return_value_ptr, zend_class_entry *
 	zephir_fcall_cache_entry **cache_entry,
 	uint param_count, zval **params TSRMLS_DC) ZEPHIR_ATTR_WARN_UNUSED_RESULT;
 
+int zephir_call_class_method_ic(zval **return_value_ptr, zend_class_entry *ce, zephir_call_type type, zval *object,
+	const char *method_name, uint method_len,
+	zephir_fcall_inline_cache *ic,
+	uint param_count, zval **params TSRMLS_DC) ZEPHIR_ATTR_WARN_UNUSED_RESULT;
+
+void zephir_fcall_cache_shutdown(void);
+
 ZEPHIR_ATTR_WARN_UNUSED_RESULT static inline int zephir_return_call_class_method(zval *return_value,
 	zval **return_value_ptr, zend_class_entry *ce, zephir_call_type type, zval *object,
 	const char *method_name, uint method_len,
@@ -544,6 +594,37 @@ ZEPHIR_ATTR_WARN_UNUSED_RESULT static inline int zephir_return_call_class_method
 	return SUCCESS;
 }
 
+ZEPHIR_ATTR_WARN_UNUSED_RESULT static inline int zephir_return_call_class_method_ic(zval *return_value,
+	zval **return_value_ptr, zend_class_entry *ce, zephir_call_type type, zval *object,
+	const char *method_name, uint method_len,
+	zephir_fcall_inline_cache *ic,
+	uint param_count, zval **params TSRMLS_DC)
+{
+	zval *rv = NULL, **rvp = return_value_ptr ? return_value_ptr : &rv;
+	int status;
+
+	if (return_value_ptr) {
+		zval_ptr_dtor(return_value_ptr);
+		*return_value_ptr = NULL;
+	}
+
+	status = zephir_call_class_method_ic(rvp, ce, type, object, method_name, method_len, ic, param_count, params TSRMLS_CC);
+
+	if (status == FAILURE) {
+		if (return_value_ptr && EG(exception)) {
+			ALLOC_INIT_ZVAL(*return_value_ptr);
+		}
+
+		return FAILURE;
+	}
+
+	if (!return_value_ptr) {
+		COPY_PZVAL_TO_ZVAL(*return_value, rv);
+	}
+
+	return SUCCESS;
+}
+
 /**
  * @brief $object->$method()
  */
@@ -625,6 +706,9 @@ ZEPHIR_ATTR_WARN_UNUSED_RESULT static inline int zephir_return_call_class_method
 /** Fast call_user_func_array/call_user_func */
 int zephir_call_user_func_array_noex(zval *return_value, zval *handler, zval *params TSRMLS_DC) ZEPHIR_ATTR_WARN_UNUSED_RESULT;
 
+/** Calls a method catching its exception, for the code that has to clean up before it propagates */
+int zephir_call_method_catch(zval **result, zval **exception, zval *object, zval *method, zval *params TSRMLS_DC);
+
 /**
  * Replaces call_user_func_array avoiding function lookup
  */
@@ -32,6 +32,8 @@
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
+#include "kernel/string.h"
+#include "kernel/filter.h"
 
 #include "Zend/zend_exceptions.h"
 #include "Zend/zend_interfaces.h"
@@ -165,22 +167,90 @@ static long zephir_unpack(char *data, int size, int issigned, int *map)
 }
 
 /**
- * Converts an unsigned long to a char*
+ * Writes an unsigned long as lowercase hexadecimal, returns the number of digits
  */
-static inline char *zephir_longtohex(unsigned long value) {
+static inline int zephir_longtohex(unsigned long value, char *buf) {
 
-	static char digits[] = "0123456789abcdef";
-	char buf[(sizeof(unsigned long) << 3) + 1];
-	char *ptr, *end;
+	static const char digits[] = "0123456789abcdef";
+	char tmp[(sizeof(unsigned long) << 1)];
+	int length = 0, i;
 
-	end = ptr = buf + sizeof(buf) - 1;
-	*ptr = '\0';
 	do {
-		*--ptr = digits[value & 0x0F];
+		tmp[length++] = digits[value & 0x0F];
 		value >>= 4;
-	} while (ptr > buf && value);
+	} while (value && length < (int) sizeof(tmp));
 
-	return estrndup(ptr, end - ptr);
+	for (i = 0; i < length; i++) {
+		buf[i] = tmp[length - i - 1];
+	}
+
+	return length;
+}
+
+/**
+ * Decodes a big endian UTF-32 code unit
+ */
+static inline long zephir_escape_unit(char *data, int *map) {
+
+	int issigned = data[0] & 0x80;
+	long value = 0;
+
+	if (sizeof(long) > 4 && issigned) {
+		value = ~INT_MAX;
+	}
+
+	value |= zephir_unpack(data, 4, issigned, map);
+	if (sizeof(long) > 4) {
+		value = (unsigned int) value;
+	}
+
+	return value;
+}
+
+/**
+ * Alphanumeric characters and, optionally, the whitelist are not escaped
+ */
+static inline int zephir_escape_is_safe(long value, int use_whitelist) {
+
+	if (value < 256 && isalnum(value)) {
+		return 1;
+	}
+
+	/**
+	 * Chararters in the whitelist are left as they are
+	 */
+	if (use_whitelist) {
+		switch (value) {
+			case ' ':
+			case '/':
+			case '*':
+			case '+':
+			case '-':
+			case '\t':
+			case '\n':
+			case '^':
+			case '$':
+			case '!':
+			case '?':
+			case '\\':
+			case '#':
+			case '}':
+			case '{':
+			case ')':
+			case '(':
+			case ']':
+			case '[':
+			case '.':
+			case ',':
+			case ':':
+			case ';':
+			case '_':
+			case '|':
+				return 1;
+		}
+	}
+
+	return 0;
 }
 
 /**
@@ -188,13 +258,11 @@ static inline char *zephir_longtohex(unsigned long value) {
  */
 void zephir_escape_multi(zval *return_value, zval *param, const char *escape_char, unsigned int escape_length, char escape_extra, int use_whitelist) {
 
-	unsigned int i;
+	unsigned int i, length = 0;
 	zval copy;
-	smart_str escaped_str = {0};
-	char machine_little_endian, *hex;
+	char machine_little_endian, *escaped, *cursor, hex[sizeof(unsigned long) << 1];
 	int big_endian_long_map[4];
 	int use_copy = 0, machine_endian_check = 1;
-	int issigned = 0;
 	long value;
 
 	if (Z_TYPE_P(param) != IS_STRING) {
@@ -204,7 +272,13 @@ void zephir_escape_multi(zval *return_value, zval *param, const char *escape_cha
 		}
 	}
 
-	if (Z_STRLEN_P(param) <= 0) {
+	/**
+	 * The input must be a valid UTF-32 string
+	 */
+	if (Z_STRLEN_P(param) <= 0 || (Z_STRLEN_P(param) % 4) != 0) {
+		if (use_copy) {
+			zval_dtor(param);
+		}
 		RETURN_FALSE;
 	}
 
@@ -226,106 +300,59 @@ void zephir_escape_multi(zval *return_value, zval *param, const char *escape_cha
 	}
 
 	/**
-	 * The input must be a valid UTF-32 string
+	 * Size the result first so it is written in a single allocation
 	 */
-	if ((Z_STRLEN_P(param) % 4) != 0) {
-		RETURN_FALSE;
-	}
-
 	for (i = 0; i < Z_STRLEN_P(param); i += 4) {
 
-		issigned = Z_STRVAL_P(param)[i] & 0x80;
-
-		value = 0;
-		if (sizeof(long) > 4 && issigned) {
-			value = ~INT_MAX;
-		}
-
-		value |= zephir_unpack(&Z_STRVAL_P(param)[i], 4, issigned, big_endian_long_map);
-		if (sizeof(long) > 4) {
-			value = (unsigned int) value;
-		}
+		value = zephir_escape_unit(&Z_STRVAL_P(param)[i], big_endian_long_map);
 
 		/**
 		 * CSS 2.1 section 4.1.3: "It is undefined in CSS 2.1 what happens if a
 		 * style sheet does contain a character with Unicode codepoint zero."
 		 */
 		if (value == '\0') {
+			if (use_copy) {
+				zval_dtor(param);
+			}
 			RETURN_FALSE;
 		}
 
-		/**
-		 * Alphanumeric characters are not escaped
-		 */
-		if (value < 256 && isalnum(value)) {
-			smart_str_appendc(&escaped_str, (unsigned char) value);
-			continue;
+		if (zephir_escape_is_safe(value, use_whitelist)) {
+			length++;
+		} else {
+			length += escape_length + zephir_longtohex(value, hex) + (escape_extra != '\0');
 		}
+	}
 
-		/**
-		 * Chararters in the whitelist are left as they are
-		 */
-		if (use_whitelist) {
-			switch (value) {
-				case ' ':
-				case '/':
-				case '*':
-				case '+':
-				case '-':
-				case '\t':
-				case '\n':
-				case '^':
-				case '$':
-				case '!':
-				case '?':
-				case '\\':
-				case '#':
-				case '}':
-				case '{':
-				case ')':
-				case '(':
-				case ']':
-				case '[':
-				case '.':
-				case ',':
-				case ':':
-				case ';':
-				case '_':
-				case '|':
-					smart_str_appendc(&escaped_str, (unsigned char) value);
-					continue;
-			}
-		}
+	escaped = cursor = emalloc(length + 1);
 
-		/**
-		 * Convert character to hexadecimal
-		 */
-		hex = zephir_longtohex(value);
+	for (i = 0; i < Z_STRLEN_P(param); i += 4) {
+
+		value = zephir_escape_unit(&Z_STRVAL_P(param)[i], big_endian_long_map);
+
+		if (zephir_escape_is_safe(value, use_whitelist)) {
+			*cursor++ = (unsigned char) value;
+			continue;
+		}
 
 		/**
 		 * Append the escaped character
 		 */
-		smart_str_appendl(&escaped_str, escape_char, escape_length);
-		smart_str_appendl(&escaped_str, hex, strlen(hex));
+		memcpy(cursor, escape_char, escape_length);
+		cursor += escape_length;
+		cursor += zephir_longtohex(value, cursor);
 		if (escape_extra != '\0') {
-			smart_str_appendc(&escaped_str, escape_extra);
+			*cursor++ = escape_extra;
 		}
-
-		efree(hex);
 	}
 
+	*cursor = '\0';
+
 	if (use_copy) {
 		zval_dtor(param);
 	}
 
-	smart_str_0(&escaped_str);
-
-	if (escaped_str.c) {
-		RETURN_STRINGL(escaped_str.c, escaped_str.len, 0);
-	} else {
-		RETURN_EMPTY_STRING();
-	}
-
+	RETURN_STRINGL(escaped, length, 0);
 }
 
 /**
@@ -349,6 +376,103 @@ void zephir_escape_htmlattr(zval *return_value, zval *param) {
 	zephir_escape_multi(return_value, param, "&#x", sizeof("&#x")-1, ';', 1);
 }
 
+/**
+ * Returns the characters htmlspecialchars() replaces for a quote style
+ */
+static inline int zephir_html_special_chars(long quote_style, char *chars) {
+
+	int length = 0;
+
+	chars[length++] = '&';
+	chars[length++] = '<';
+	chars[length++] = '>';
+	if (quote_style & ENT_HTML_QUOTE_DOUBLE) {
+		chars[length++] = '"';
+	}
+	if (quote_style & ENT_HTML_QUOTE_SINGLE) {
+		chars[length++] = '\'';
+	}
+
+	return length;
+}
+
+/**
+ * Checks whether htmlspecialchars() would return the string unchanged:
+ * it must be plain ASCII without special characters for the quote style
+ */
+int zephir_is_html_safe(const char *str, unsigned int length, long quote_style) {
+
+	char chars[5];
+
+#ifdef ENT_HTML_SUBSTITUTE_DISALLOWED_CHARS
+	/* Control characters may be replaced depending on the document type */
+	if (quote_style & ENT_HTML_SUBSTITUTE_DISALLOWED_CHARS) {
+		return 0;
+	}
+#endif
+
+	return zephir_ascii_span(str, length, chars, zephir_html_special_chars(quote_style, chars)) == length;
+}
+
+/**
+ * Escapes an ASCII string in a single sized pass, returns NULL if a non-ASCII
+ * byte is found so that the charset aware implementation handles it
+ */
+static char *zephir_escape_html_ascii(const char *str, unsigned int length, long quote_style, unsigned int *escaped_length) {
+
+	char chars[5], *escaped, *cursor;
+	const char *apos = "&#039;";
+	int chars_len = zephir_html_special_chars(quote_style, chars);
+	unsigned int i, run, size = 0;
+
+#ifdef ENT_HTML_DOC_TYPE_MASK
+	if ((quote_style & ENT_HTML_DOC_TYPE_MASK) != ENT_HTML_DOC_HTML401) {
+		apos = "&apos;";
+	}
+#endif
+
+	for (i = 0; i < length; i++) {
+		run = zephir_ascii_span(str + i, length - i, chars, chars_len);
+		size += run;
+		i    += run;
+		if (i == length) {
+			break;
+		}
+		switch (str[i]) {
+			case '&':  size += sizeof("&amp;") - 1; break;
+			case '<':  size += sizeof("&lt;") - 1; break;
+			case '>':  size += sizeof("&gt;") - 1; break;
+			case '"':  size += sizeof("&quot;") - 1; break;
+			case '\'': size += strlen(apos); break;
+			default:   return NULL;
+		}
+	}
+
+	escaped = cursor = emalloc(size + 1);
+
+	for (i = 0; i < length; i++) {
+		run = zephir_ascii_span(str + i, length - i, chars, chars_len);
+		memcpy(cursor, str + i, run);
+		cursor += run;
+		i      += run;
+		if (i == length) {
+			break;
+		}
+		switch (str[i]) {
+			case '&':  memcpy(cursor, "&amp;", sizeof("&amp;") - 1); cursor += sizeof("&amp;") - 1; break;
+			case '<':  memcpy(cursor, "&lt;", sizeof("&lt;") - 1); cursor += sizeof("&lt;") - 1; break;
+			case '>':  memcpy(cursor, "&gt;", sizeof("&gt;") - 1); cursor += sizeof("&gt;") - 1; break;
+			case '"':  memcpy(cursor, "&quot;", sizeof("&quot;") - 1); cursor += sizeof("&quot;") - 1; break;
+			case '\'': memcpy(cursor, apos, strlen(apos)); cursor += strlen(apos); break;
+		}
+	}
+
+	*cursor = '\0';
+	*escaped_length = size;
+
+	return escaped;
+}
+
 /**
  * Escapes HTML replacing special chars by entities
  */
@@ -361,6 +485,7 @@ void zephir_escape_html(zval *return_value, zval *str, zval *quote_style, zval *
 	#endif
 
 	char *escaped;
+	unsigned int ascii_length;
 
 	if (Z_TYPE_P(str) != IS_STRING) {
 		/* Nothing to escape */
@@ -372,12 +497,25 @@ void zephir_escape_html(zval *return_value, zval *str, zval *quote_style, zval *
 		RETURN_ZVAL(str, 1, 0);
 	}
 
-	if (Z_TYPE_P(charset) != IS_STRING) {
+	if (Z_TYPE_P(charset) != IS_STRING && Z_TYPE_P(charset) != IS_NULL) {
 		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Invalid charset supplied for zephir_escape_html()");
 		RETURN_ZVAL(str, 1, 0);
 	}
 
-	escaped = php_escape_html_entities((unsigned char*) Z_STRVAL_P(str), Z_STRLEN_P(str), &length, 0, Z_LVAL_P(quote_style), Z_STRVAL_P(charset) TSRMLS_CC);
+	if (zephir_is_html_safe(Z_STRVAL_P(str), Z_STRLEN_P(str), Z_LVAL_P(quote_style))) {
+		RETURN_ZVAL(str, 1, 0);
+	}
+
+#ifndef ENT_HTML_SUBSTITUTE_DISALLOWED_CHARS
+	escaped = zephir_escape_html_ascii(Z_STRVAL_P(str), Z_STRLEN_P(str), Z_LVAL_P(quote_style), &ascii_length);
+#else
+	escaped = (Z_LVAL_P(quote_style) & ENT_HTML_SUBSTITUTE_DISALLOWED_CHARS) ? NULL : zephir_escape_html_ascii(Z_STRVAL_P(str), Z_STRLEN_P(str), Z_LVAL_P(quote_style), &ascii_length);
+#endif
+	if (escaped) {
+		RETURN_STRINGL(escaped, ascii_length, 0);
+	}
+
+	escaped = php_escape_html_entities((unsigned char*) Z_STRVAL_P(str), Z_STRLEN_P(str), &length, 0, Z_LVAL_P(quote_style), Z_TYPE_P(charset) == IS_STRING ? Z_STRVAL_P(charset) : NULL TSRMLS_CC);
 
 	RETURN_STRINGL(escaped, length, 0);
 }
@@ -28,4 +28,5 @@ void zephir_is_basic_charset(zval *return_value, const zval *param);
 void zephir_escape_css(zval *return_value, zval *param);
 void zephir_escape_js(zval *return_value, zval *param);
 void zephir_escape_htmlattr(zval *return_value, zval *param);
-void zephir_escape_html(zval *return_value, zval *str, zval *quote_style, zval *charset TSRMLS_DC);
\ No newline at end of file
+void zephir_escape_html(zval *return_value, zval *str, zval *quote_style, zval *charset TSRMLS_DC);
+int zephir_is_html_safe(const char *str, unsigned int length, long quote_style);
\ No newline at end of file
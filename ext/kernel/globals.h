@@ -23,6 +23,16 @@
 
 #define ZEPHIR_MAX_MEMORY_STACK 48
 
+/** The frame arena keeps its state in static storage, so it is only used in non-thread-safe builds */
+#ifndef ZTS
+#define ZEPHIR_USE_MEMORY_ARENA 1
+#endif
+
+/** Kernel counters live in static storage as well, thread-safe builds report them as zero */
+#ifndef ZTS
+#define ZEPHIR_USE_KERNEL_STATS 1
+#endif
+
 /** Memory frame */
 typedef struct _zephir_memory_entry {
 	size_t pointer;
@@ -33,6 +43,10 @@ typedef struct _zephir_memory_entry {
 	zval ***hash_addresses;
 	struct _zephir_memory_entry *prev;
 	struct _zephir_memory_entry *next;
+#ifdef ZEPHIR_USE_MEMORY_ARENA
+	struct _zephir_arena_chunk *arena_chunk;
+	size_t arena_offset;
+#endif
 #ifndef ZEPHIR_RELEASE
 	const char *func;
 #endif
@@ -29,11 +29,17 @@
 #include "kernel/main.h"
 #include "kernel/memory.h"
 #include "kernel/fcall.h"
+#include "kernel/object.h"
 #include "kernel/exception.h"
 
 #include "Zend/zend_exceptions.h"
 #include "Zend/zend_interfaces.h"
 
+#include <time.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
 /**
  * Initializes internal interface with extends
  */
@@ -433,3 +439,55 @@ zend_class_entry* zephir_get_internal_ce(const char *class_name, unsigned int cl
 
     return *temp_ce;
 }
+
+/**
+ * Releases the persistent memory the kernel keeps between requests
+ */
+void zephir_kernel_shutdown(void) {
+
+	zephir_fcall_cache_shutdown();
+	zephir_memory_arena_shutdown();
+	zephir_constructor_signatures_shutdown();
+	zephir_accessor_tables_shutdown();
+}
+
+static void zephir_kernel_shutdown_dtor(zend_rsrc_list_entry *rsrc TSRMLS_DC) {
+	zephir_kernel_shutdown();
+}
+
+/**
+ * Registers zephir_kernel_shutdown() from MINIT as the destructor of a persistent list entry, so it runs
+ * at module shutdown even in release builds where the generated MSHUTDOWN is compiled out
+ */
+void zephir_kernel_register_shutdown(int module_number TSRMLS_DC) {
+
+	zend_rsrc_list_entry le;
+
+	le.type = zend_register_list_destructors_ex(NULL, zephir_kernel_shutdown_dtor, "zephir kernel", module_number);
+	le.ptr = NULL;
+	le.refcount = 1;
+
+	zend_hash_next_index_insert(&EG(persistent_list), &le, sizeof(zend_rsrc_list_entry), NULL);
+}
+
+/**
+ * Returns a time in seconds, measured from an arbitrary point by a clock that system time changes do not affect.
+ * Falls back to the wall clock where no monotonic clock is available
+ */
+double zephir_monotonic_time(void) {
+
+#if defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+		return (double) ts.tv_sec + (double) ts.tv_nsec / 1000000000.0;
+	}
+#endif
+
+	{
+		struct timeval tv;
+
+		gettimeofday(&tv, NULL);
+		return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+	}
+}
@@ -103,6 +103,13 @@ void zephir_safe_zval_ptr_dtor(zval *pzval);
 /* Fetch Parameters */
 int zephir_fetch_parameters(int num_args TSRMLS_DC, int required_args, int optional_args, ...);
 
+/** Time */
+double zephir_monotonic_time(void);
+
+/** Module shutdown */
+void zephir_kernel_shutdown(void);
+void zephir_kernel_register_shutdown(int module_number TSRMLS_DC);
+
 /** Symbols */
 #define ZEPHIR_READ_SYMBOL(var, auxarr, name) if (EG(active_symbol_table)){ \
 	if (zend_hash_find(EG(active_symbol_table), name, sizeof(name), (void **)  &auxarr) == SUCCESS) { \
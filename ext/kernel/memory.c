@@ -24,6 +24,7 @@
 
 #include <Zend/zend_alloc.h>
 
+#include "kernel/main.h"
 #include "kernel/fcall.h"
 #include "kernel/backtrace.h"
 
@@ -45,6 +46,229 @@
  * Not all methods must grow/restore the zephir_memory_entry.
  */
 
+/*
+ * Frame Arena
+ *------------
+ *
+ * Frames allocated beyond the preallocated stack, together with their
+ * address slabs, are carved from a chain of large chunks by a bump allocator.
+ * Frames are strictly LIFO, so every frame records the arena position at the
+ * moment it was created and restoring the frame rewinds the arena to that mark.
+ *
+ * The first chunk survives between requests; extra chunks are released once
+ * the request stack is fully unwound.
+ */
+
+#ifdef ZEPHIR_USE_MEMORY_ARENA
+
+#define ZEPHIR_ARENA_CHUNK_SIZE (64 * 1024)
+#define ZEPHIR_ARENA_ALIGN(size) (((size) + (sizeof(void*) - 1)) & ~(sizeof(void*) - 1))
+
+typedef struct _zephir_arena_chunk {
+	struct _zephir_arena_chunk *next;
+	size_t size;
+	size_t base;
+	char data[1];
+} zephir_arena_chunk;
+
+typedef struct _zephir_memory_arena {
+	zephir_arena_chunk *first;
+	zephir_arena_chunk *current;
+	size_t offset;
+	size_t chunks;
+	size_t peak;
+	size_t peak_chunks;
+} zephir_memory_arena;
+
+static zephir_memory_arena zephir_arena = { NULL, NULL, 0, 0, 0, 0 };
+
+static zephir_arena_chunk *zephir_arena_new_chunk(size_t size, zephir_arena_chunk *prev)
+{
+	zephir_arena_chunk *chunk;
+
+	if (size < ZEPHIR_ARENA_CHUNK_SIZE) {
+		size = ZEPHIR_ARENA_CHUNK_SIZE;
+	}
+
+	chunk = (zephir_arena_chunk *) pemalloc(sizeof(zephir_arena_chunk) - 1 + size, 1);
+	chunk->next = NULL;
+	chunk->size = size;
+	chunk->base = prev ? prev->base + prev->size : 0;
+
+	++zephir_arena.chunks;
+	if (zephir_arena.chunks > zephir_arena.peak_chunks) {
+		zephir_arena.peak_chunks = zephir_arena.chunks;
+	}
+
+	return chunk;
+}
+
+/**
+ * Frees every chunk following the given one
+ */
+static void zephir_arena_free_after(zephir_arena_chunk *chunk)
+{
+	zephir_arena_chunk *next = chunk->next, *tmp;
+
+	chunk->next = NULL;
+	while (next) {
+		tmp = next->next;
+		pefree(next, 1);
+		--zephir_arena.chunks;
+		next = tmp;
+	}
+}
+
+/**
+ * Bump-allocates a block from the frame arena
+ */
+static void *zephir_arena_alloc(size_t size)
+{
+	zephir_arena_chunk *chunk = zephir_arena.current;
+	size_t used;
+	void *ptr;
+
+	size = ZEPHIR_ARENA_ALIGN(size);
+
+	if (UNEXPECTED(!chunk)) {
+		if (!zephir_arena.first) {
+			zephir_arena.first = zephir_arena_new_chunk(size, NULL);
+		}
+		chunk = zephir_arena.current = zephir_arena.first;
+		zephir_arena.offset = 0;
+	}
+
+	if (UNEXPECTED(zephir_arena.offset + size > chunk->size)) {
+		/* Everything past the current chunk is free, reuse it when it is large enough */
+		if (!chunk->next || chunk->next->size < size) {
+			zephir_arena_free_after(chunk);
+			chunk->next = zephir_arena_new_chunk(size, chunk);
+		}
+		chunk = zephir_arena.current = chunk->next;
+		zephir_arena.offset = 0;
+	}
+
+	ptr = chunk->data + zephir_arena.offset;
+	zephir_arena.offset += size;
+
+	used = chunk->base + zephir_arena.offset;
+	if (used > zephir_arena.peak) {
+		zephir_arena.peak = used;
+	}
+
+	return ptr;
+}
+
+/**
+ * Rewinds the arena to a mark taken when a frame was created
+ */
+static inline void zephir_arena_rewind(zephir_arena_chunk *chunk, size_t offset)
+{
+	zephir_arena.current = chunk;
+	zephir_arena.offset  = offset;
+}
+
+/**
+ * Drops the extra chunks once the request no longer has active frames
+ */
+static void zephir_arena_trim(void)
+{
+	if (zephir_arena.first) {
+		zephir_arena_free_after(zephir_arena.first);
+	}
+
+	zephir_arena.current = NULL;
+	zephir_arena.offset  = 0;
+}
+
+#endif
+
+/**
+ * Reports the usage and high-water mark of the frame arena
+ */
+void zephir_memory_arena_stats(zephir_arena_stats *stats)
+{
+#ifdef ZEPHIR_USE_MEMORY_ARENA
+	zephir_arena_chunk *chunk;
+
+	stats->used        = zephir_arena.current ? zephir_arena.current->base + zephir_arena.offset : 0;
+	stats->peak        = zephir_arena.peak;
+	stats->chunks      = zephir_arena.chunks;
+	stats->peak_chunks = zephir_arena.peak_chunks;
+	stats->reserved    = 0;
+	for (chunk = zephir_arena.first; chunk; chunk = chunk->next) {
+		stats->reserved += chunk->size;
+	}
+#else
+	memset(stats, 0, sizeof(zephir_arena_stats));
+#endif
+}
+
+/**
+ * Frees the first chunk of the frame arena, kept between requests, called at module shutdown through zephir_kernel_shutdown()
+ */
+void zephir_memory_arena_shutdown(void)
+{
+#ifdef ZEPHIR_USE_MEMORY_ARENA
+	if (zephir_arena.first) {
+		zephir_arena_free_after(zephir_arena.first);
+		pefree(zephir_arena.first, 1);
+		--zephir_arena.chunks;
+		zephir_arena.first = NULL;
+	}
+
+	zephir_arena.current = NULL;
+	zephir_arena.offset  = 0;
+#endif
+}
+
+#ifdef ZEPHIR_USE_KERNEL_STATS
+zephir_kernel_counters zephir_kernel_stats_counters;
+#endif
+
+/**
+ * Exports the kernel counters and the frame arena usage as an associative array,
+ * optionally clearing the counters afterwards. The current depth is never cleared
+ */
+void zephir_kernel_stats(zval *return_value, int reset TSRMLS_DC)
+{
+	zephir_kernel_counters counters;
+	zephir_arena_stats arena;
+
+#ifdef ZEPHIR_USE_KERNEL_STATS
+	counters = zephir_kernel_stats_counters;
+#else
+	memset(&counters, 0, sizeof(zephir_kernel_counters));
+#endif
+
+	zephir_memory_arena_stats(&arena);
+
+	array_init_size(return_value, 16);
+	add_assoc_long_ex(return_value, SS("framesGrown"),     (long) counters.frames_grown);
+	add_assoc_long_ex(return_value, SS("depth"),           (long) counters.depth);
+	add_assoc_long_ex(return_value, SS("maxDepth"),        (long) counters.max_depth);
+	add_assoc_long_ex(return_value, SS("zvalsObserved"),   (long) counters.zvals_observed);
+	add_assoc_long_ex(return_value, SS("symbolTables"),    (long) counters.symbol_tables);
+	add_assoc_long_ex(return_value, SS("fcacheHits"),      (long) counters.fcache_hits);
+	add_assoc_long_ex(return_value, SS("fcacheMisses"),    (long) counters.fcache_misses);
+	add_assoc_long_ex(return_value, SS("propertyLookups"), (long) counters.property_lookups);
+	add_assoc_long_ex(return_value, SS("propertyIcHits"),  (long) counters.property_ic_hits);
+	add_assoc_long_ex(return_value, SS("concatAllocs"),    (long) counters.concat_allocs);
+	add_assoc_long_ex(return_value, SS("requests"),        (long) counters.requests);
+	add_assoc_long_ex(return_value, SS("arenaUsed"),       (long) arena.used);
+	add_assoc_long_ex(return_value, SS("arenaPeak"),       (long) arena.peak);
+	add_assoc_long_ex(return_value, SS("arenaChunks"),     (long) arena.chunks);
+	add_assoc_long_ex(return_value, SS("arenaReserved"),   (long) arena.reserved);
+
+#ifdef ZEPHIR_USE_KERNEL_STATS
+	if (reset) {
+		memset(&zephir_kernel_stats_counters, 0, sizeof(zephir_kernel_counters));
+		zephir_kernel_stats_counters.depth     = counters.depth;
+		zephir_kernel_stats_counters.max_depth = counters.depth;
+	}
+#endif
+}
+
 static zephir_memory_entry* zephir_memory_grow_stack_common(zend_zephir_globals_def *g)
 {
 	assert(g->start_memory != NULL);
@@ -56,7 +280,27 @@ static zephir_memory_entry* zephir_memory_grow_stack_common(zend_zephir_globals_
 	}
 	else if (!g->active_memory->next) {
 		assert(g->active_memory >= g->end_memory - 1 || g->active_memory < g->start_memory);
+#ifdef ZEPHIR_USE_MEMORY_ARENA
+		zephir_arena_chunk *mark_chunk;
+		size_t mark_offset;
+		zephir_memory_entry *entry;
+
+		if (UNEXPECTED(!zephir_arena.current)) {
+			/* Rewinding to an empty mark resets the arena to its first chunk */
+			mark_chunk  = NULL;
+			mark_offset = 0;
+		} else {
+			mark_chunk  = zephir_arena.current;
+			mark_offset = zephir_arena.offset;
+		}
+
+		entry = (zephir_memory_entry *) zephir_arena_alloc(sizeof(zephir_memory_entry));
+		memset(entry, 0, sizeof(zephir_memory_entry));
+		entry->arena_chunk  = mark_chunk;
+		entry->arena_offset = mark_offset;
+#else
 		zephir_memory_entry *entry = (zephir_memory_entry *) ecalloc(1, sizeof(zephir_memory_entry));
+#endif
 	/* ecalloc() will take care of these members
 		entry->pointer   = 0;
 		entry->capacity  = 0;
@@ -85,6 +329,13 @@ static zephir_memory_entry* zephir_memory_grow_stack_common(zend_zephir_globals_
 	assert(g->active_memory->pointer == 0);
 	assert(g->active_memory->hash_pointer == 0);
 
+#ifdef ZEPHIR_USE_KERNEL_STATS
+	++zephir_kernel_stats_counters.frames_grown;
+	if (++zephir_kernel_stats_counters.depth > zephir_kernel_stats_counters.max_depth) {
+		zephir_kernel_stats_counters.max_depth = zephir_kernel_stats_counters.depth;
+	}
+#endif
+
 	return g->active_memory;
 }
 
@@ -97,6 +348,12 @@ static void zephir_memory_restore_stack_common(zend_zephir_globals_def *g TSRMLS
 	active_memory = g->active_memory;
 	assert(active_memory != NULL);
 
+#ifdef ZEPHIR_USE_KERNEL_STATS
+	if (EXPECTED(zephir_kernel_stats_counters.depth > 0)) {
+		--zephir_kernel_stats_counters.depth;
+	}
+#endif
+
 	if (EXPECTED(!CG(unclean_shutdown))) {
 		/* Clean active symbol table */
 		if (g->active_symbol_table) {
@@ -174,6 +431,10 @@ static void zephir_memory_restore_stack_common(zend_zephir_globals_def *g TSRMLS
 #endif
 		assert(prev != NULL);
 
+#ifdef ZEPHIR_USE_MEMORY_ARENA
+		/* The frame and its slabs were the last blocks carved from the arena */
+		zephir_arena_rewind(active_memory->arena_chunk, active_memory->arena_offset);
+#else
 		if (active_memory->hash_addresses != NULL) {
 			efree(active_memory->hash_addresses);
 		}
@@ -183,6 +444,7 @@ static void zephir_memory_restore_stack_common(zend_zephir_globals_def *g TSRMLS
 		}
 
 		efree(g->active_memory);
+#endif
 		g->active_memory = prev;
 		prev->next = NULL;
 	}
@@ -327,19 +589,44 @@ int ZEND_FASTCALL zephir_memory_restore_stack(TSRMLS_D)
 }
 #endif
 
-ZEPHIR_ATTR_NONNULL static void zephir_reallocate_memory(const zend_zephir_globals_def *g)
+/**
+ * Grows an address slab by doubling its capacity
+ */
+static zval ***zephir_grow_slab(zval ***slab, size_t used, size_t *capacity, size_t initial, int persistent)
 {
-	zephir_memory_entry *frame = g->active_memory;
-	int persistent = (frame >= g->start_memory && frame < g->end_memory);
-	void *buf = perealloc(frame->addresses, sizeof(zval **) * (frame->capacity + 16), persistent);
-	if (EXPECTED(buf != NULL)) {
-		frame->capacity += 16;
-		frame->addresses = buf;
+	size_t new_capacity = *capacity ? *capacity * 2 : initial;
+	zval ***buf;
+
+#ifdef ZEPHIR_USE_MEMORY_ARENA
+	if (!persistent) {
+		/* The old slab is reclaimed when the frame rewinds the arena */
+		buf = (zval ***) zephir_arena_alloc(sizeof(zval **) * new_capacity);
+		if (used) {
+			memcpy(buf, slab, sizeof(zval **) * used);
+		}
 	}
-	else {
+	else
+#endif
+	{
+		buf = perealloc(slab, sizeof(zval **) * new_capacity, persistent);
+	}
+
+	if (UNEXPECTED(buf == NULL)) {
 		zend_error(E_CORE_ERROR, "Memory allocation failed");
+		return slab;
 	}
 
+	*capacity = new_capacity;
+	return buf;
+}
+
+ZEPHIR_ATTR_NONNULL static void zephir_reallocate_memory(const zend_zephir_globals_def *g)
+{
+	zephir_memory_entry *frame = g->active_memory;
+	int persistent = (frame >= g->start_memory && frame < g->end_memory);
+
+	frame->addresses = zephir_grow_slab(frame->addresses, frame->pointer, &frame->capacity, 16, persistent);
+
 #ifndef ZEPHIR_RELEASE
 	assert(frame->permanent == persistent);
 #endif
@@ -349,14 +636,8 @@ ZEPHIR_ATTR_NONNULL static void zephir_reallocate_hmemory(const zend_zephir_glob
 {
 	zephir_memory_entry *frame = g->active_memory;
 	int persistent = (frame >= g->start_memory && frame < g->end_memory);
-	void *buf = perealloc(frame->hash_addresses, sizeof(zval **) * (frame->hash_capacity + 4), persistent);
-	if (EXPECTED(buf != NULL)) {
-		frame->hash_capacity += 4;
-		frame->hash_addresses = buf;
-	}
-	else {
-		zend_error(E_CORE_ERROR, "Memory allocation failed");
-	}
+
+	frame->hash_addresses = zephir_grow_slab(frame->hash_addresses, frame->hash_pointer, &frame->hash_capacity, 4, persistent);
 
 #ifndef ZEPHIR_RELEASE
 	assert(frame->permanent == persistent);
@@ -393,6 +674,8 @@ ZEPHIR_ATTR_NONNULL1(2) static inline void zephir_do_memory_observe(zval **var,
 
 	frame->addresses[frame->pointer] = var;
 	++frame->pointer;
+
+	ZEPHIR_KERNEL_STAT_INC(zvals_observed);
 }
 
 /**
@@ -451,6 +734,11 @@ void ZEND_FASTCALL zephir_memory_remove(zval **var TSRMLS_DC) {
 	*var = NULL;
 }
 
+/**
+ * Current generation of the kernel inline caches
+ */
+zend_uint zephir_cache_epoch = 1;
+
 /**
  * Cleans the phalcon memory stack recursivery
  */
@@ -462,6 +750,17 @@ int ZEND_FASTCALL zephir_clean_restore_stack(TSRMLS_D) {
 		zephir_memory_restore_stack_common(zephir_globals_ptr TSRMLS_CC);
 	}
 
+#ifdef ZEPHIR_USE_MEMORY_ARENA
+	zephir_arena_trim();
+#endif
+
+	ZEPHIR_KERNEL_STAT_INC(requests);
+
+	/* Classes and functions cached during this request may not survive it */
+	if (UNEXPECTED(++zephir_cache_epoch == ZEPHIR_CACHE_EPOCH_PERSISTENT)) {
+		zephir_cache_epoch = 1;
+	}
+
 	return SUCCESS;
 }
 
@@ -502,6 +801,8 @@ void zephir_create_symbol_table(TSRMLS_D) {
 	ALLOC_HASHTABLE(symbol_table);
 	zend_hash_init(symbol_table, 0, NULL, ZVAL_PTR_DTOR, 0);
 	EG(active_symbol_table) = symbol_table;
+
+	ZEPHIR_KERNEL_STAT_INC(symbol_tables);
 }
 
 /**
@@ -52,6 +52,47 @@ void ZEPHIR_FASTCALL zephir_memory_alloc_pnull(zval **var TSRMLS_DC);
 
 int ZEPHIR_FASTCALL zephir_clean_restore_stack(TSRMLS_D);
 
+/* Frame arena */
+typedef struct _zephir_arena_stats {
+	size_t used;
+	size_t peak;
+	size_t chunks;
+	size_t peak_chunks;
+	size_t reserved;
+} zephir_arena_stats;
+
+void zephir_memory_arena_stats(zephir_arena_stats *stats);
+void zephir_memory_arena_shutdown(void);
+
+/* Kernel counters, kept in release builds too */
+typedef struct _zephir_kernel_counters {
+	ulong frames_grown;
+	ulong depth;
+	ulong max_depth;
+	ulong zvals_observed;
+	ulong symbol_tables;
+	ulong fcache_hits;
+	ulong fcache_misses;
+	ulong property_lookups;
+	ulong property_ic_hits;
+	ulong concat_allocs;
+	ulong requests;
+} zephir_kernel_counters;
+
+#ifdef ZEPHIR_USE_KERNEL_STATS
+extern zephir_kernel_counters zephir_kernel_stats_counters;
+#define ZEPHIR_KERNEL_STAT_INC(field) (++zephir_kernel_stats_counters.field)
+#else
+#define ZEPHIR_KERNEL_STAT_INC(field)
+#endif
+
+void zephir_kernel_stats(zval *return_value, int reset TSRMLS_DC);
+
+/* Inline caches: entries tagged with an older epoch were filled by a previous request */
+#define ZEPHIR_CACHE_EPOCH_PERSISTENT 0
+
+extern zend_uint zephir_cache_epoch;
+
 /* Virtual symbol tables */
 void zephir_create_symbol_table(TSRMLS_D);
 /*void zephir_restore_symbol_table(TSRMLS_D);*/
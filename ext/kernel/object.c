@@ -22,6 +22,9 @@
 #include "config.h"
 #endif
 
+/* This file implements the functions wrapped by the property inline cache macros */
+#define ZEPHIR_KERNEL_OBJECT_C 1
+
 #include "php.h"
 
 #ifdef PHP_WIN32
@@ -464,6 +467,8 @@ int zephir_read_property(zval **result, zval *object, const char *property_name,
 		return FAILURE;
 	}
 
+	ZEPHIR_KERNEL_STAT_INC(property_lookups);
+
 	ce = Z_OBJCE_P(object);
 	if (ce->parent) {
 		ce = zephir_lookup_class_ce(ce, property_name, property_length TSRMLS_CC);
@@ -516,6 +521,8 @@ zval* zephir_fetch_property_this_quick(zval *object, const char *property_name,
 
 	if (likely(Z_TYPE_P(object) == IS_OBJECT)) {
 
+		ZEPHIR_KERNEL_STAT_INC(property_lookups);
+
 		ce = Z_OBJCE_P(object);
 		if (ce->parent) {
 			ce = zephir_lookup_class_ce_quick(ce, property_name, property_length, key TSRMLS_CC);
@@ -813,6 +820,44 @@ int zephir_update_property_zval(zval *object, const char *property_name, unsigne
 	return SUCCESS;
 }
 
+#if PHP_VERSION_ID >= 50400
+/**
+ * Assigns a value to a property slot, as zend_std_write_property does
+ */
+static inline void zephir_assign_property_slot(zval **variable_ptr, zval *value)
+{
+	if (EXPECTED(*variable_ptr != value)) {
+
+		/* if we are assigning reference, we shouldn't move it, but instead assign variable to the same pointer */
+		if (PZVAL_IS_REF(*variable_ptr)) {
+
+			zval garbage = **variable_ptr; /* old value should be destroyed */
+
+			/* To check: can't *variable_ptr be some system variable like error_zval here? */
+			Z_TYPE_PP(variable_ptr) = Z_TYPE_P(value);
+			(*variable_ptr)->value = value->value;
+			if (Z_REFCOUNT_P(value) > 0) {
+				zval_copy_ctor(*variable_ptr);
+			} else {
+				efree(value);
+			}
+			zval_dtor(&garbage);
+
+		} else {
+			zval *garbage = *variable_ptr;
+
+			/* if we assign referenced variable, we should separate it */
+			Z_ADDREF_P(value);
+			if (PZVAL_IS_REF(value)) {
+				SEPARATE_ZVAL(&value);
+			}
+			*variable_ptr = value;
+			zval_ptr_dtor(&garbage);
+		}
+	}
+}
+#endif
+
 /**
  * Updates properties on this_ptr (quick)
  * Variables must be defined in the class definition. This function ignores magic methods or dynamic properties
@@ -873,37 +918,7 @@ int zephir_update_property_this_quick(zval *object, const char *property_name, z
 
 			/** This is as zend_std_write_property, but we're not interesed in validate properties visibility */
 			if (property_info->offset >= 0 ? (zobj->properties ? ((variable_ptr = (zval**) zobj->properties_table[property_info->offset]) != NULL) : (*(variable_ptr = &zobj->properties_table[property_info->offset]) != NULL)) : (EXPECTED(zobj->properties != NULL) && EXPECTED(zephir_hash_quick_find(zobj->properties, property_info->name, property_info->name_length + 1, property_info->h, (void **) &variable_ptr) == SUCCESS))) {
-
-				if (EXPECTED(*variable_ptr != value)) {
-
-					/* if we are assigning reference, we shouldn't move it, but instead assign variable to the same pointer */
-					if (PZVAL_IS_REF(*variable_ptr)) {
-
-						zval garbage = **variable_ptr; /* old value should be destroyed */
-
-						/* To check: can't *variable_ptr be some system variable like error_zval here? */
-						Z_TYPE_PP(variable_ptr) = Z_TYPE_P(value);
-						(*variable_ptr)->value = value->value;
-						if (Z_REFCOUNT_P(value) > 0) {
-							zval_copy_ctor(*variable_ptr);
-						} else {
-							efree(value);
-						}
-						zval_dtor(&garbage);
-
-					} else {
-						zval *garbage = *variable_ptr;
-
-						/* if we assign referenced variable, we should separate it */
-						Z_ADDREF_P(value);
-						if (PZVAL_IS_REF(value)) {
-							SEPARATE_ZVAL(&value);
-						}
-						*variable_ptr = value;
-						zval_ptr_dtor(&garbage);
-					}
-				}
-
+				zephir_assign_property_slot(variable_ptr, value);
 			}
 		}
 	}
@@ -924,6 +939,119 @@ int zephir_update_property_this(zval *object, char *property_name, unsigned int
 	return zephir_update_property_this_quick(object, property_name, property_length, value, zend_inline_hash_func(property_name, property_length + 1) TSRMLS_CC);
 }
 
+#if PHP_VERSION_ID >= 50400
+
+/**
+ * Resolves the property slot for the class of an object through the inline cache of the access site
+ */
+static inline zend_property_info *zephir_property_ic_lookup(zephir_property_ic *ic, zend_class_entry *ce, const char *property_name, zend_uint property_length TSRMLS_DC)
+{
+	zend_property_info *property_info;
+	zend_class_entry *declaring_ce;
+	ulong key;
+
+	if (EXPECTED(ic->ce == ce) && EXPECTED(ic->name == property_name) && EXPECTED(ic->epoch == zephir_cache_epoch || ic->epoch == ZEPHIR_CACHE_EPOCH_PERSISTENT)) {
+		return ic->property_info;
+	}
+
+	key = zend_hash_func(property_name, property_length + 1);
+	declaring_ce = ce->parent ? zephir_lookup_class_ce_quick(ce, property_name, property_length, key TSRMLS_CC) : ce;
+
+	if (zephir_hash_quick_find(&declaring_ce->properties_info, property_name, property_length + 1, key, (void **) &property_info) == FAILURE) {
+		return NULL;
+	}
+
+	if (UNEXPECTED((property_info->flags & ZEND_ACC_STATIC) != 0 || property_info->offset < 0)) {
+		return NULL;
+	}
+
+	ic->ce            = ce;
+	ic->name          = property_name;
+	ic->property_info = property_info;
+	ic->epoch         = (ce->type == ZEND_INTERNAL_CLASS) ? ZEPHIR_CACHE_EPOCH_PERSISTENT : zephir_cache_epoch;
+
+	return property_info;
+}
+
+/**
+ * Returns the address of a declared property slot or NULL if it is not initialized
+ */
+static inline zval **zephir_property_ic_slot(zval *object, const zend_property_info *property_info TSRMLS_DC)
+{
+	zend_object *zobj = zend_objects_get_address(object TSRMLS_CC);
+	zval **zv;
+
+	if (zobj->properties) {
+		zv = (zval**) zobj->properties_table[property_info->offset];
+		return (zv && *zv) ? zv : NULL;
+	}
+
+	zv = &zobj->properties_table[property_info->offset];
+	return *zv ? zv : NULL;
+}
+
+/**
+ * Fetches a declared property using the inline cache of the access site
+ */
+zval* zephir_fetch_property_this_ic(zephir_property_ic *ic, zval *object, const char *property_name, zend_uint property_length, int silent TSRMLS_DC) {
+
+	zend_property_info *property_info;
+	zval **zv;
+
+	if (likely(Z_TYPE_P(object) == IS_OBJECT)) {
+		property_info = zephir_property_ic_lookup(ic, Z_OBJCE_P(object), property_name, property_length TSRMLS_CC);
+		if (likely(property_info != NULL) && (zv = zephir_property_ic_slot(object, property_info TSRMLS_CC)) != NULL) {
+			ZEPHIR_KERNEL_STAT_INC(property_ic_hits);
+			return *zv;
+		}
+	}
+
+	return zephir_fetch_property_this_quick(object, property_name, property_length, zend_hash_func(property_name, property_length + 1), silent TSRMLS_CC);
+}
+
+/**
+ * Reads a property from an object using the inline cache of the access site.
+ * Only objects with the standard read_property handler take the cached path
+ */
+int zephir_read_property_ic(zephir_property_ic *ic, zval **result, zval *object, const char *property_name, zend_uint property_length, int silent TSRMLS_DC) {
+
+	zend_property_info *property_info;
+	zval **zv;
+
+	if (likely(Z_TYPE_P(object) == IS_OBJECT) && likely(Z_OBJ_HT_P(object)->read_property == zend_std_read_property)) {
+		property_info = zephir_property_ic_lookup(ic, Z_OBJCE_P(object), property_name, property_length TSRMLS_CC);
+		if (likely(property_info != NULL) && (zv = zephir_property_ic_slot(object, property_info TSRMLS_CC)) != NULL) {
+			ZEPHIR_KERNEL_STAT_INC(property_ic_hits);
+			*result = *zv;
+			Z_ADDREF_PP(result);
+			return SUCCESS;
+		}
+	}
+
+	return zephir_read_property(result, object, property_name, property_length, silent TSRMLS_CC);
+}
+
+/**
+ * Updates a declared property using the inline cache of the access site
+ */
+int zephir_update_property_this_ic(zephir_property_ic *ic, zval *object, const char *property_name, zend_uint property_length, zval *value TSRMLS_DC) {
+
+	zend_property_info *property_info;
+	zval **variable_ptr;
+
+	if (likely(Z_TYPE_P(object) == IS_OBJECT)) {
+		property_info = zephir_property_ic_lookup(ic, Z_OBJCE_P(object), property_name, property_length TSRMLS_CC);
+		if (likely(property_info != NULL) && (variable_ptr = zephir_property_ic_slot(object, property_info TSRMLS_CC)) != NULL) {
+			zephir_assign_property_slot(variable_ptr, value);
+			return SUCCESS;
+		}
+	}
+
+	return zephir_update_property_this_quick(object, property_name, property_length, value, zend_hash_func(property_name, property_length + 1) TSRMLS_CC);
+}
+
+#endif
+
 /**
  * Checks whether obj is an object and updates zval property with another zval
  */
@@ -1602,120 +1730,1401 @@ int zephir_update_static_property_array_multi_ce(zend_class_entry *ce, const cha
 }
 
 /**
- * Update a static property
+ * Finds the bucket of an array key
  */
-int zephir_update_static_property(const char *class_name, unsigned int class_length, char *name, unsigned int name_length, zval *value TSRMLS_DC){
-	zend_class_entry **ce;
-	if (zend_lookup_class(class_name, class_length, &ce TSRMLS_CC) == SUCCESS) {
-		return zend_update_static_property(*ce, name, name_length, value TSRMLS_CC);
-	}
+static int zephir_array_key_find(HashTable *ht, const zval *key, zval ***child)
+{
+	switch (Z_TYPE_P(key)) {
 
-	return FAILURE;
-}
+		case IS_NULL:
+			return zend_hash_find(ht, "", 1, (void**) child);
 
-int zephir_read_class_property(zval **result, int type, const char *property, int len TSRMLS_DC) {
-	zend_class_entry *ce;
+		case IS_DOUBLE:
+			return zend_hash_index_find(ht, (ulong) Z_DVAL_P(key), (void**) child);
 
-	type |= (ZEND_FETCH_CLASS_SILENT | ZEND_FETCH_CLASS_NO_AUTOLOAD);
-	type &= ZEND_FETCH_CLASS_MASK;
-	ce    = zend_fetch_class(NULL, 0, type TSRMLS_CC);
+		case IS_LONG:
+		case IS_BOOL:
+		case IS_RESOURCE:
+			return zend_hash_index_find(ht, Z_LVAL_P(key), (void**) child);
 
-	if (likely(ce != NULL)) {
-		return zephir_read_static_property_ce(result, ce, property, len TSRMLS_CC);
-	}
+		case IS_STRING:
+			return zend_symtable_find(ht, Z_STRVAL_P(key), Z_STRLEN_P(key) + 1, (void**) child);
 
-	return FAILURE;
+		default:
+			zend_error(E_WARNING, "Illegal offset type");
+			return FAILURE;
+	}
 }
 
 /**
- * Creates a new instance dynamically. Call constructor without parameters
+ * Stores a value under an array key, the reference count of the value is not changed
  */
-int zephir_create_instance(zval *return_value, const zval *class_name TSRMLS_DC){
+static int zephir_array_key_update(HashTable *ht, const zval *key, zval *value, zval ***child)
+{
+	switch (Z_TYPE_P(key)) {
 
-	zend_class_entry *ce;
+		case IS_NULL:
+			return zend_symtable_update(ht, "", 1, &value, sizeof(zval*), (void**) child);
 
-	if (Z_TYPE_P(class_name) != IS_STRING) {
-		zephir_throw_exception_string(spl_ce_RuntimeException, SL("Invalid class name") TSRMLS_CC);
-		return FAILURE;
+		case IS_DOUBLE:
+			return zend_hash_index_update(ht, (ulong) Z_DVAL_P(key), &value, sizeof(zval*), (void**) child);
+
+		case IS_LONG:
+		case IS_BOOL:
+		case IS_RESOURCE:
+			return zend_hash_index_update(ht, Z_LVAL_P(key), &value, sizeof(zval*), (void**) child);
+
+		case IS_STRING:
+			return zend_symtable_update(ht, Z_STRVAL_P(key), Z_STRLEN_P(key) + 1, &value, sizeof(zval*), (void**) child);
+
+		default:
+			zend_error(E_WARNING, "Illegal offset type");
+			return FAILURE;
 	}
+}
 
-	ce = zend_fetch_class(Z_STRVAL_P(class_name), Z_STRLEN_P(class_name), ZEND_FETCH_CLASS_DEFAULT TSRMLS_CC);
-	if (!ce) {
-		return FAILURE;
+/**
+ * Removes an array key
+ */
+static int zephir_array_key_delete(HashTable *ht, const zval *key)
+{
+	switch (Z_TYPE_P(key)) {
+
+		case IS_NULL:
+			return zend_hash_del(ht, "", 1);
+
+		case IS_DOUBLE:
+			return zend_hash_index_del(ht, (ulong) Z_DVAL_P(key));
+
+		case IS_LONG:
+		case IS_BOOL:
+		case IS_RESOURCE:
+			return zend_hash_index_del(ht, Z_LVAL_P(key));
+
+		case IS_STRING:
+			return zend_symtable_del(ht, Z_STRVAL_P(key), Z_STRLEN_P(key) + 1);
+
+		default:
+			zend_error(E_WARNING, "Illegal offset type");
+			return FAILURE;
 	}
+}
 
-	object_init_ex(return_value, ce);
-	if (zephir_has_constructor_ce(ce)) {
-		return zephir_call_class_method_aparams(NULL, ce, zephir_fcall_method, return_value, SL("__construct"), NULL, 0, NULL TSRMLS_CC);
+/**
+ * Checks whether every key of a path exists, so an unset does not separate arrays it will not change
+ */
+static int zephir_array_path_exists(const zval *arr, int keys_count, va_list ap)
+{
+	zval **child;
+	int i;
+
+	for (i = 0; i < keys_count; i++) {
+		if (Z_TYPE_P(arr) != IS_ARRAY || zephir_array_key_find(Z_ARRVAL_P(arr), va_arg(ap, zval*), &child) == FAILURE) {
+			return 0;
+		}
+		arr = *child;
 	}
 
-	return SUCCESS;
+	return 1;
 }
 
 /**
- * Creates a new instance dynamically calling constructor with parameters
+ * Walks a path of keys from a slot and applies an operation to the last level.
+ * Only the arrays along the path are separated, missing levels are created as
+ * empty arrays, so updates take constant time whatever the size of the array
  */
-int zephir_create_instance_params(zval *return_value, const zval *class_name, zval *params TSRMLS_DC){
-
-	int outcome;
-	zend_class_entry *ce;
+static int zephir_array_path_apply(zval **slot, int operation, zval *value, int keys_count, va_list ap)
+{
+	zval **child, *key, *level;
+	int i, depth = keys_count;
 
-	if (Z_TYPE_P(class_name) != IS_STRING) {
-		zephir_throw_exception_string(spl_ce_RuntimeException, SL("Invalid class name") TSRMLS_CC);
-		return FAILURE;
+	if (operation == ZEPHIR_ARRAY_PATH_UPDATE || operation == ZEPHIR_ARRAY_PATH_UNSET) {
+		depth--;
 	}
 
-	if (Z_TYPE_P(params) != IS_ARRAY) {
-		zephir_throw_exception_string(spl_ce_RuntimeException, SL("Instantiation parameters must be an array") TSRMLS_CC);
-		return FAILURE;
-	}
+	if (operation == ZEPHIR_ARRAY_PATH_UNSET) {
 
-	ce = zend_fetch_class(Z_STRVAL_P(class_name), Z_STRLEN_P(class_name), ZEND_FETCH_CLASS_DEFAULT TSRMLS_CC);
-	if (!ce) {
-		return FAILURE;
+		va_list keys;
+		int exists;
+
+		va_copy(keys, ap);
+		exists = zephir_array_path_exists(*slot, keys_count, keys);
+		va_end(keys);
+
+		if (!exists) {
+			return SUCCESS;
+		}
 	}
 
-	object_init_ex(return_value, ce);
-	outcome = SUCCESS;
+	SEPARATE_ZVAL_IF_NOT_REF(slot);
+	if (Z_TYPE_PP(slot) != IS_ARRAY) {
+		zval_dtor(*slot);
+		array_init(*slot);
+	}
 
-	if (zephir_has_constructor_ce(ce)) {
-		int param_count = zend_hash_num_elements(Z_ARRVAL_P(params));
-		zval *static_params[10];
-		zval **params_ptr, **params_arr = NULL;
+	for (i = 0; i < depth; i++) {
 
-		if (param_count > 0) {
-			HashPosition pos;
-			zval **item;
-			int i = 0;
+		key = va_arg(ap, zval*);
 
-			if (likely(param_count) <= 10) {
-				params_ptr = static_params;
+		if (zephir_array_key_find(Z_ARRVAL_PP(slot), key, &child) == FAILURE) {
+			MAKE_STD_ZVAL(level);
+			array_init(level);
+			if (zephir_array_key_update(Z_ARRVAL_PP(slot), key, level, &child) == FAILURE) {
+				zval_ptr_dtor(&level);
+				return FAILURE;
 			}
-			else {
-				params_arr = emalloc(param_count * sizeof(zval*));
-				params_ptr = &params;
+		}
+
+		slot = child;
+		SEPARATE_ZVAL_IF_NOT_REF(slot);
+		if (Z_TYPE_PP(slot) != IS_ARRAY) {
+			zval_dtor(*slot);
+			array_init(*slot);
+		}
+	}
+
+	switch (operation) {
+
+		case ZEPHIR_ARRAY_PATH_UPDATE:
+			Z_ADDREF_P(value);
+			if (zephir_array_key_update(Z_ARRVAL_PP(slot), va_arg(ap, zval*), value, NULL) == FAILURE) {
+				Z_DELREF_P(value);
+				return FAILURE;
 			}
+			break;
 
-			for (
-				zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(params), &pos);
-				zend_hash_get_current_data_ex(Z_ARRVAL_P(params), (void**)&item, &pos) == SUCCESS;
-				zend_hash_move_forward_ex(Z_ARRVAL_P(params), &pos), ++i
-			) {
-				params_ptr[i] = *item;
+		case ZEPHIR_ARRAY_PATH_APPEND:
+			Z_ADDREF_P(value);
+			if (zend_hash_next_index_insert(Z_ARRVAL_PP(slot), &value, sizeof(zval*), NULL) == FAILURE) {
+				Z_DELREF_P(value);
+				return FAILURE;
 			}
-		}
-		else {
-			params_ptr = NULL;
-		}
+			break;
 
-		outcome = zephir_call_class_method_aparams(NULL, ce, zephir_fcall_method, return_value, SL("__construct"), NULL, param_count, params_ptr TSRMLS_CC);
+		case ZEPHIR_ARRAY_PATH_PREPEND:
+			zephir_array_unshift(*slot, value);
+			break;
 
-		if (unlikely(params_arr != NULL)) {
-			efree(params_arr);
+		case ZEPHIR_ARRAY_PATH_UNSET:
+			zephir_array_key_delete(Z_ARRVAL_PP(slot), va_arg(ap, zval*));
+			break;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * slot[k1]...[kn] = value (or [], array_unshift, unset), updated in place.
+ * Lets native object storage share the in-place primitives of array properties,
+ * the slot must hold a zval
+ */
+int zephir_array_slot_apply(zval **slot, int operation, zval *value, int keys_count, ...)
+{
+	va_list ap;
+	int status;
+
+	va_start(ap, keys_count);
+	status = zephir_array_path_apply(slot, operation, value, keys_count, ap);
+	va_end(ap);
+
+	return status;
+}
+
+/**
+ * Returns the slot of an object property so it can be modified in place,
+ * NULL if the object only exposes the property through its handlers
+ */
+static zval **zephir_property_array_slot(zval *object, const char *property, zend_uint property_length TSRMLS_DC)
+{
+	zend_class_entry *ce, *old_scope;
+	zval **slot, member;
+#if PHP_VERSION_ID >= 50400
+	zend_property_info *property_info;
+	ulong key = zend_hash_func(property, property_length + 1);
+#endif
+
+	ce = Z_OBJCE_P(object);
+
+#if PHP_VERSION_ID >= 50400
+	if (ce->parent) {
+		ce = zephir_lookup_class_ce_quick(ce, property, property_length, key TSRMLS_CC);
+	}
+
+	/* Declared properties are modified directly in the properties table */
+	if (zephir_hash_quick_find(&ce->properties_info, property, property_length + 1, key, (void **) &property_info) == SUCCESS) {
+		if ((property_info->flags & ZEND_ACC_STATIC) == 0 && property_info->offset >= 0) {
+			if ((slot = zephir_property_ic_slot(object, property_info TSRMLS_CC)) != NULL) {
+				return slot;
+			}
 		}
 	}
+#else
+	if (ce->parent) {
+		ce = zephir_lookup_class_ce(ce, property, property_length TSRMLS_CC);
+	}
+#endif
 
-	return outcome;
+	if (!Z_OBJ_HT_P(object)->get_property_ptr_ptr) {
+		return NULL;
+	}
+
+	INIT_ZVAL(member);
+	ZVAL_STRINGL(&member, property, property_length, 0);
+
+	old_scope = EG(scope);
+	EG(scope) = ce;
+
+#if PHP_VERSION_ID < 50400
+	slot = Z_OBJ_HT_P(object)->get_property_ptr_ptr(object, &member TSRMLS_CC);
+#elif PHP_VERSION_ID < 50500
+	slot = Z_OBJ_HT_P(object)->get_property_ptr_ptr(object, &member, NULL TSRMLS_CC);
+#else
+	slot = Z_OBJ_HT_P(object)->get_property_ptr_ptr(object, &member, BP_VAR_W, NULL TSRMLS_CC);
+#endif
+
+	EG(scope) = old_scope;
+
+	return slot;
+}
+
+/**
+ * Applies an operation to an array property in place, objects using magic
+ * accessors are updated through a copy that is written back
+ */
+static int zephir_property_array_apply(zval *object, const char *property, zend_uint property_length, int operation, zval *value, int keys_count, va_list ap TSRMLS_DC)
+{
+	zval **slot, *tmp;
+	int status;
+
+	if (unlikely(Z_TYPE_P(object) != IS_OBJECT)) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Attempt to assign property of non-object");
+		return FAILURE;
+	}
+
+	slot = zephir_property_array_slot(object, property, property_length TSRMLS_CC);
+	if (likely(slot != NULL)) {
+		return zephir_array_path_apply(slot, operation, value, keys_count, ap);
+	}
+
+	zephir_read_property(&tmp, object, property, property_length, PH_NOISY TSRMLS_CC);
+	SEPARATE_ZVAL(&tmp);
+
+	status = zephir_array_path_apply(&tmp, operation, value, keys_count, ap);
+	if (status == SUCCESS) {
+		zephir_update_property_zval(object, property, property_length, tmp TSRMLS_CC);
+	}
+
+	zval_ptr_dtor(&tmp);
+	return status;
+}
+
+/**
+ * this->property[k1]...[kn] = value, updated in place
+ */
+int zephir_property_array_update(zval *object, const char *property, zend_uint property_length, zval *value TSRMLS_DC, int keys_count, ...)
+{
+	va_list ap;
+	int status;
+
+	va_start(ap, keys_count);
+	status = zephir_property_array_apply(object, property, property_length, ZEPHIR_ARRAY_PATH_UPDATE, value, keys_count, ap TSRMLS_CC);
+	va_end(ap);
+
+	return status;
+}
+
+/**
+ * this->property[k1]...[kn][] = value, updated in place
+ */
+int zephir_property_array_append(zval *object, const char *property, zend_uint property_length, zval *value TSRMLS_DC, int keys_count, ...)
+{
+	va_list ap;
+	int status;
+
+	va_start(ap, keys_count);
+	status = zephir_property_array_apply(object, property, property_length, ZEPHIR_ARRAY_PATH_APPEND, value, keys_count, ap TSRMLS_CC);
+	va_end(ap);
+
+	return status;
+}
+
+/**
+ * array_unshift(this->property[k1]...[kn], value), updated in place
+ */
+int zephir_property_array_prepend(zval *object, const char *property, zend_uint property_length, zval *value TSRMLS_DC, int keys_count, ...)
+{
+	va_list ap;
+	int status;
+
+	va_start(ap, keys_count);
+	status = zephir_property_array_apply(object, property, property_length, ZEPHIR_ARRAY_PATH_PREPEND, value, keys_count, ap TSRMLS_CC);
+	va_end(ap);
+
+	return status;
+}
+
+/**
+ * unset(this->property[k1]...[kn]), updated in place
+ */
+int zephir_property_array_unset(zval *object, const char *property, zend_uint property_length TSRMLS_DC, int keys_count, ...)
+{
+	va_list ap;
+	int status;
+
+	va_start(ap, keys_count);
+	status = zephir_property_array_apply(object, property, property_length, ZEPHIR_ARRAY_PATH_UNSET, NULL, keys_count, ap TSRMLS_CC);
+	va_end(ap);
+
+	return status;
+}
+
+/**
+ * Applies an operation to a static array property in place
+ */
+static int zephir_static_property_array_apply(zend_class_entry *ce, const char *property, zend_uint property_length, int operation, zval *value, int keys_count, va_list ap TSRMLS_DC)
+{
+	zend_class_entry *old_scope = EG(scope);
+	zval **slot;
+
+	EG(scope) = ce;
+#if PHP_VERSION_ID < 50400
+	slot = zend_std_get_static_property(ce, property, property_length, 0 TSRMLS_CC);
+#else
+	slot = zephir_std_get_static_property(ce, property, property_length, 0, 0, NULL TSRMLS_CC);
+#endif
+	EG(scope) = old_scope;
+
+	if (!slot) {
+		return FAILURE;
+	}
+
+	return zephir_array_path_apply(slot, operation, value, keys_count, ap);
+}
+
+/**
+ * self::property[k1]...[kn] = value, updated in place
+ */
+int zephir_static_property_array_update(zend_class_entry *ce, const char *property, zend_uint property_length, zval *value TSRMLS_DC, int keys_count, ...)
+{
+	va_list ap;
+	int status;
+
+	va_start(ap, keys_count);
+	status = zephir_static_property_array_apply(ce, property, property_length, ZEPHIR_ARRAY_PATH_UPDATE, value, keys_count, ap TSRMLS_CC);
+	va_end(ap);
+
+	return status;
+}
+
+/**
+ * self::property[k1]...[kn][] = value, updated in place
+ */
+int zephir_static_property_array_append(zend_class_entry *ce, const char *property, zend_uint property_length, zval *value TSRMLS_DC, int keys_count, ...)
+{
+	va_list ap;
+	int status;
+
+	va_start(ap, keys_count);
+	status = zephir_static_property_array_apply(ce, property, property_length, ZEPHIR_ARRAY_PATH_APPEND, value, keys_count, ap TSRMLS_CC);
+	va_end(ap);
+
+	return status;
+}
+
+/**
+ * array_unshift(self::property[k1]...[kn], value), updated in place
+ */
+int zephir_static_property_array_prepend(zend_class_entry *ce, const char *property, zend_uint property_length, zval *value TSRMLS_DC, int keys_count, ...)
+{
+	va_list ap;
+	int status;
+
+	va_start(ap, keys_count);
+	status = zephir_static_property_array_apply(ce, property, property_length, ZEPHIR_ARRAY_PATH_PREPEND, value, keys_count, ap TSRMLS_CC);
+	va_end(ap);
+
+	return status;
+}
+
+/**
+ * unset(self::property[k1]...[kn]), updated in place
+ */
+int zephir_static_property_array_unset(zend_class_entry *ce, const char *property, zend_uint property_length TSRMLS_DC, int keys_count, ...)
+{
+	va_list ap;
+	int status;
+
+	va_start(ap, keys_count);
+	status = zephir_static_property_array_apply(ce, property, property_length, ZEPHIR_ARRAY_PATH_UNSET, NULL, keys_count, ap TSRMLS_CC);
+	va_end(ap);
+
+	return status;
+}
+
+/**
+ * Update a static property
+ */
+int zephir_update_static_property(const char *class_name, unsigned int class_length, char *name, unsigned int name_length, zval *value TSRMLS_DC){
+	zend_class_entry **ce;
+	if (zend_lookup_class(class_name, class_length, &ce TSRMLS_CC) == SUCCESS) {
+		return zend_update_static_property(*ce, name, name_length, value TSRMLS_CC);
+	}
+
+	return FAILURE;
+}
+
+int zephir_read_class_property(zval **result, int type, const char *property, int len TSRMLS_DC) {
+	zend_class_entry *ce;
+
+	type |= (ZEND_FETCH_CLASS_SILENT | ZEND_FETCH_CLASS_NO_AUTOLOAD);
+	type &= ZEND_FETCH_CLASS_MASK;
+	ce    = zend_fetch_class(NULL, 0, type TSRMLS_CC);
+
+	if (likely(ce != NULL)) {
+		return zephir_read_static_property_ce(result, ce, property, len TSRMLS_CC);
+	}
+
+	return FAILURE;
+}
+
+/**
+ * Creates a new instance dynamically. Call constructor without parameters
+ */
+int zephir_create_instance(zval *return_value, const zval *class_name TSRMLS_DC){
+
+	zend_class_entry *ce;
+
+	if (Z_TYPE_P(class_name) != IS_STRING) {
+		zephir_throw_exception_string(spl_ce_RuntimeException, SL("Invalid class name") TSRMLS_CC);
+		return FAILURE;
+	}
+
+	ce = zend_fetch_class(Z_STRVAL_P(class_name), Z_STRLEN_P(class_name), ZEND_FETCH_CLASS_DEFAULT TSRMLS_CC);
+	if (!ce) {
+		return FAILURE;
+	}
+
+	object_init_ex(return_value, ce);
+	if (zephir_has_constructor_ce(ce)) {
+		return zephir_call_class_method_aparams(NULL, ce, zephir_fcall_method, return_value, SL("__construct"), NULL, 0, NULL TSRMLS_CC);
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Creates a new instance dynamically calling constructor with parameters
+ */
+int zephir_create_instance_params(zval *return_value, const zval *class_name, zval *params TSRMLS_DC){
+
+	int outcome;
+	zend_class_entry *ce;
+
+	if (Z_TYPE_P(class_name) != IS_STRING) {
+		zephir_throw_exception_string(spl_ce_RuntimeException, SL("Invalid class name") TSRMLS_CC);
+		return FAILURE;
+	}
+
+	if (Z_TYPE_P(params) != IS_ARRAY) {
+		zephir_throw_exception_string(spl_ce_RuntimeException, SL("Instantiation parameters must be an array") TSRMLS_CC);
+		return FAILURE;
+	}
+
+	ce = zend_fetch_class(Z_STRVAL_P(class_name), Z_STRLEN_P(class_name), ZEND_FETCH_CLASS_DEFAULT TSRMLS_CC);
+	if (!ce) {
+		return FAILURE;
+	}
+
+	object_init_ex(return_value, ce);
+	outcome = SUCCESS;
+
+	if (zephir_has_constructor_ce(ce)) {
+		int param_count = zend_hash_num_elements(Z_ARRVAL_P(params));
+		zval *static_params[10];
+		zval **params_ptr, **params_arr = NULL;
+
+		if (param_count > 0) {
+			HashPosition pos;
+			zval **item;
+			int i = 0;
+
+			if (likely(param_count) <= 10) {
+				params_ptr = static_params;
+			}
+			else {
+				params_arr = emalloc(param_count * sizeof(zval*));
+				params_ptr = params_arr;
+			}
+
+			for (
+				zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(params), &pos);
+				zend_hash_get_current_data_ex(Z_ARRVAL_P(params), (void**)&item, &pos) == SUCCESS;
+				zend_hash_move_forward_ex(Z_ARRVAL_P(params), &pos), ++i
+			) {
+				params_ptr[i] = *item;
+			}
+		}
+		else {
+			params_ptr = NULL;
+		}
+
+		outcome = zephir_call_class_method_aparams(NULL, ce, zephir_fcall_method, return_value, SL("__construct"), NULL, param_count, params_ptr TSRMLS_CC);
+
+		if (unlikely(params_arr != NULL)) {
+			efree(params_arr);
+		}
+	}
+
+	return outcome;
+}
+
+/**
+ * Creates a new instance calling the constructor of the class entry directly, as
+ * ReflectionClass::newInstanceArgs() does, then assigns the given properties
+ */
+int zephir_create_instance_config(zval *return_value, const zval *class_name, zval *params, zval *properties TSRMLS_DC){
+
+	zend_class_entry *ce;
+	zend_function *constructor;
+	zend_fcall_info fci;
+	zend_fcall_info_cache fcc;
+	zval **static_params[10], ***params_ptr = NULL, ***params_arr = NULL, **item, *retval_ptr = NULL;
+	HashPosition pos;
+	char *str_key;
+	uint str_key_len;
+	ulong num_key;
+	int param_count = 0, i = 0;
+
+	if (Z_TYPE_P(class_name) != IS_STRING) {
+		zephir_throw_exception_string(spl_ce_RuntimeException, SL("Invalid class name") TSRMLS_CC);
+		return FAILURE;
+	}
+
+	if (Z_TYPE_P(params) != IS_ARRAY) {
+		zephir_throw_exception_string(spl_ce_RuntimeException, SL("Instantiation parameters must be an array") TSRMLS_CC);
+		return FAILURE;
+	}
+
+	ce = zend_fetch_class(Z_STRVAL_P(class_name), Z_STRLEN_P(class_name), ZEND_FETCH_CLASS_DEFAULT TSRMLS_CC);
+	if (!ce) {
+		return FAILURE;
+	}
+
+	object_init_ex(return_value, ce);
+
+	constructor = Z_OBJ_HT_P(return_value)->get_constructor(return_value TSRMLS_CC);
+	if (constructor) {
+
+		if (!(constructor->common.fn_flags & ZEND_ACC_PUBLIC)) {
+			zephir_throw_exception_string(spl_ce_RuntimeException, SL("Access to non-public constructor") TSRMLS_CC);
+			return FAILURE;
+		}
+
+		param_count = zend_hash_num_elements(Z_ARRVAL_P(params));
+		if (param_count > 0) {
+			if (likely(param_count <= 10)) {
+				params_ptr = static_params;
+			} else {
+				params_arr = emalloc(param_count * sizeof(zval**));
+				params_ptr = params_arr;
+			}
+
+			for (
+				zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(params), &pos);
+				zend_hash_get_current_data_ex(Z_ARRVAL_P(params), (void**) &item, &pos) == SUCCESS;
+				zend_hash_move_forward_ex(Z_ARRVAL_P(params), &pos), ++i
+			) {
+				params_ptr[i] = item;
+			}
+		}
+
+		fci.size           = sizeof(fci);
+		fci.function_table = EG(function_table);
+		fci.function_name  = NULL;
+		fci.symbol_table   = NULL;
+		fci.object_ptr     = return_value;
+		fci.retval_ptr_ptr = &retval_ptr;
+		fci.param_count    = param_count;
+		fci.params         = params_ptr;
+		fci.no_separation  = 1;
+
+		fcc.initialized      = 1;
+		fcc.function_handler = constructor;
+		fcc.calling_scope    = EG(scope);
+		fcc.called_scope     = Z_OBJCE_P(return_value);
+		fcc.object_ptr       = return_value;
+
+		i = zend_call_function(&fci, &fcc TSRMLS_CC);
+
+		if (unlikely(params_arr != NULL)) {
+			efree(params_arr);
+		}
+
+		if (retval_ptr) {
+			zval_ptr_dtor(&retval_ptr);
+		}
+
+		if (i == FAILURE) {
+			zephir_throw_exception_string(spl_ce_RuntimeException, SL("Invocation of the constructor failed") TSRMLS_CC);
+			return FAILURE;
+		}
+	}
+
+	if (properties && Z_TYPE_P(properties) == IS_ARRAY) {
+		for (
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(properties), &pos);
+			!EG(exception) && zend_hash_get_current_data_ex(Z_ARRVAL_P(properties), (void**) &item, &pos) == SUCCESS;
+			zend_hash_move_forward_ex(Z_ARRVAL_P(properties), &pos)
+		) {
+			if (zend_hash_get_current_key_ex(Z_ARRVAL_P(properties), &str_key, &str_key_len, &num_key, 0, &pos) == HASH_KEY_IS_STRING) {
+				zephir_update_property_zval(return_value, str_key, str_key_len - 1, *item TSRMLS_CC);
+			}
+		}
+	}
+
+	return EG(exception) ? FAILURE : SUCCESS;
+}
+
+/*
+ * Constructor signatures
+ *-----------------------
+ *
+ * Parameter names, type-hinted class names and default values of constructors
+ * are kept in persistent memory, so classes do not need to be reflected on again
+ * in later requests. Entries of user classes remember the modification time of
+ * the files declaring the class and its constructor and are rebuilt once either
+ * of them changes; the files are checked at most once per request.
+ */
+#ifndef ZTS
+
+typedef struct _zephir_ctor_param {
+	char *name;
+	zend_uint name_len;
+	char *class_name;
+	zend_uint class_name_len;
+	zval *default_value;
+} zephir_ctor_param;
+
+typedef struct _zephir_ctor_signature {
+	zend_uint num_args;
+	zephir_ctor_param *params;
+	char *file;
+	time_t file_mtime;
+	char *ctor_file;
+	time_t ctor_mtime;
+	zend_uint epoch;
+} zephir_ctor_signature;
+
+static HashTable *zephir_ctor_signatures = NULL;
+
+/**
+ * Checks whether a value can be copied out of the request memory
+ */
+static int zephir_zval_is_persistable(const zval *value)
+{
+	HashPosition pos;
+	zval **item;
+
+	switch (Z_TYPE_P(value) & IS_CONSTANT_TYPE_MASK) {
+
+		case IS_NULL:
+		case IS_LONG:
+		case IS_DOUBLE:
+		case IS_BOOL:
+		case IS_STRING:
+		case IS_CONSTANT:
+			return 1;
+
+		case IS_ARRAY:
+		case IS_CONSTANT_ARRAY:
+			for (
+				zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(value), &pos);
+				zend_hash_get_current_data_ex(Z_ARRVAL_P(value), (void**) &item, &pos) == SUCCESS;
+				zend_hash_move_forward_ex(Z_ARRVAL_P(value), &pos)
+			) {
+				if (!zephir_zval_is_persistable(*item)) {
+					return 0;
+				}
+			}
+			return 1;
+	}
+
+	return 0;
+}
+
+static void zephir_persistent_zval_dtor(void *data);
+
+/**
+ * Deep-copies a value made of scalars, constants and arrays either to persistent or to request memory
+ */
+static zval *zephir_zval_deep_copy(const zval *value, int persistent)
+{
+	HashTable *ht;
+	HashPosition pos;
+	zval *copy, **item, *item_copy;
+	char *str_key;
+	uint str_key_len;
+	ulong num_key;
+
+	if (persistent) {
+		copy = pemalloc(sizeof(zval), 1);
+	} else {
+		ALLOC_ZVAL(copy);
+	}
+
+	INIT_PZVAL_COPY(copy, value);
+
+	switch (Z_TYPE_P(value) & IS_CONSTANT_TYPE_MASK) {
+
+		case IS_STRING:
+		case IS_CONSTANT:
+			Z_STRVAL_P(copy) = pemalloc(Z_STRLEN_P(value) + 1, persistent);
+			memcpy(Z_STRVAL_P(copy), Z_STRVAL_P(value), Z_STRLEN_P(value) + 1);
+			break;
+
+		case IS_ARRAY:
+		case IS_CONSTANT_ARRAY:
+			ht = pemalloc(sizeof(HashTable), persistent);
+			zend_hash_init(ht, zend_hash_num_elements(Z_ARRVAL_P(value)), NULL, persistent ? zephir_persistent_zval_dtor : ZVAL_PTR_DTOR, persistent);
+			for (
+				zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(value), &pos);
+				zend_hash_get_current_data_ex(Z_ARRVAL_P(value), (void**) &item, &pos) == SUCCESS;
+				zend_hash_move_forward_ex(Z_ARRVAL_P(value), &pos)
+			) {
+				item_copy = zephir_zval_deep_copy(*item, persistent);
+				if (zend_hash_get_current_key_ex(Z_ARRVAL_P(value), &str_key, &str_key_len, &num_key, 0, &pos) == HASH_KEY_IS_STRING) {
+					zend_hash_update(ht, str_key, str_key_len, &item_copy, sizeof(zval*), NULL);
+				} else {
+					zend_hash_index_update(ht, num_key, &item_copy, sizeof(zval*), NULL);
+				}
+			}
+			Z_ARRVAL_P(copy) = ht;
+			break;
+	}
+
+	return copy;
+}
+
+/**
+ * Releases a value created by zephir_zval_deep_copy() in persistent memory
+ */
+static void zephir_persistent_zval_free(zval *value)
+{
+	switch (Z_TYPE_P(value) & IS_CONSTANT_TYPE_MASK) {
+
+		case IS_STRING:
+		case IS_CONSTANT:
+			pefree(Z_STRVAL_P(value), 1);
+			break;
+
+		case IS_ARRAY:
+		case IS_CONSTANT_ARRAY:
+			zend_hash_destroy(Z_ARRVAL_P(value));
+			pefree(Z_ARRVAL_P(value), 1);
+			break;
+	}
+
+	pefree(value, 1);
+}
+
+static void zephir_persistent_zval_dtor(void *data)
+{
+	zephir_persistent_zval_free(*(zval **) data);
+}
+
+static void zephir_ctor_signature_dtor(void *data)
+{
+	zephir_ctor_signature *signature = *(zephir_ctor_signature **) data;
+	zend_uint i;
+
+	for (i = 0; i < signature->num_args; ++i) {
+		pefree(signature->params[i].name, 1);
+		if (signature->params[i].class_name) {
+			pefree(signature->params[i].class_name, 1);
+		}
+		if (signature->params[i].default_value) {
+			zephir_persistent_zval_free(signature->params[i].default_value);
+		}
+	}
+
+	if (signature->params) {
+		pefree(signature->params, 1);
+	}
+	if (signature->file) {
+		pefree(signature->file, 1);
+	}
+	if (signature->ctor_file) {
+		pefree(signature->ctor_file, 1);
+	}
+	pefree(signature, 1);
+}
+
+/**
+ * Returns the modification time of a file, source files of internal classes never change
+ */
+static int zephir_source_mtime(const char *file, time_t *mtime TSRMLS_DC)
+{
+	struct stat st;
+
+	if (!file) {
+		*mtime = 0;
+		return SUCCESS;
+	}
+
+	if (VCWD_STAT(file, &st) != 0) {
+		return FAILURE;
+	}
+
+	*mtime = st.st_mtime;
+	return SUCCESS;
+}
+
+static inline const char *zephir_class_file(const zend_class_entry *ce)
+{
+	if (ce->type != ZEND_USER_CLASS) {
+		return NULL;
+	}
+
+#if PHP_VERSION_ID < 50400
+	return ce->filename;
+#else
+	return ce->info.user.filename;
+#endif
+}
+
+/**
+ * Finds the default value of a constructor parameter like ReflectionParameter::getDefaultValue() does
+ */
+static zval *zephir_ctor_default_value(const zend_function *constructor, zend_uint offset)
+{
+	zend_op *op, *end;
+
+	if (constructor->type != ZEND_USER_FUNCTION) {
+		return NULL;
+	}
+
+	op  = constructor->op_array.opcodes;
+	end = op + constructor->op_array.last;
+	for (; op < end; ++op) {
+#if PHP_VERSION_ID < 50400
+		if ((op->opcode == ZEND_RECV || op->opcode == ZEND_RECV_INIT) && Z_LVAL(op->op1.u.constant) == (long) offset + 1) {
+			return op->opcode == ZEND_RECV_INIT ? &op->op2.u.constant : NULL;
+		}
+#else
+		if ((op->opcode == ZEND_RECV || op->opcode == ZEND_RECV_INIT) && op->op1.num == offset + 1) {
+			return op->opcode == ZEND_RECV_INIT ? op->op2.zv : NULL;
+		}
+#endif
+	}
+
+	return NULL;
+}
+
+/**
+ * Captures the constructor signature of a class, returns NULL when it cannot be cached
+ */
+static zephir_ctor_signature *zephir_ctor_signature_create(zend_class_entry *ce TSRMLS_DC)
+{
+	zephir_ctor_signature *signature;
+	zend_function *constructor = ce->constructor;
+	zend_class_entry *scope = constructor ? constructor->common.scope : ce;
+	const char *file = zephir_class_file(ce), *ctor_file = NULL, *class_name;
+	zend_uint i, class_name_len;
+	zval *default_value;
+	time_t file_mtime, ctor_mtime;
+
+	if (constructor && constructor->type == ZEND_USER_FUNCTION) {
+		ctor_file = constructor->op_array.filename;
+	}
+
+	if (zephir_source_mtime(file, &file_mtime TSRMLS_CC) == FAILURE || zephir_source_mtime(ctor_file, &ctor_mtime TSRMLS_CC) == FAILURE) {
+		return NULL;
+	}
+
+	if (constructor) {
+		for (i = 0; i < constructor->common.num_args; ++i) {
+			default_value = zephir_ctor_default_value(constructor, i);
+			if (default_value && !zephir_zval_is_persistable(default_value)) {
+				return NULL;
+			}
+		}
+	}
+
+	signature = pecalloc(1, sizeof(zephir_ctor_signature), 1);
+	signature->file       = file ? pestrdup(file, 1) : NULL;
+	signature->file_mtime = file_mtime;
+	signature->ctor_file  = ctor_file ? pestrdup(ctor_file, 1) : NULL;
+	signature->ctor_mtime = ctor_mtime;
+	signature->epoch      = zephir_cache_epoch;
+
+	if (!constructor || !constructor->common.num_args) {
+		return signature;
+	}
+
+	signature->num_args = constructor->common.num_args;
+	signature->params   = pecalloc(signature->num_args, sizeof(zephir_ctor_param), 1);
+
+	for (i = 0; i < signature->num_args; ++i) {
+
+		const zend_arg_info *arg_info = &constructor->common.arg_info[i];
+
+		signature->params[i].name     = pestrndup(arg_info->name, arg_info->name_len, 1);
+		signature->params[i].name_len = arg_info->name_len;
+
+		class_name = arg_info->class_name;
+		class_name_len = arg_info->class_name_len;
+		if (class_name) {
+			/* Resolve the hints relative to the declaring class as ReflectionParameter::getClass() does */
+			if (class_name_len == sizeof("self") - 1 && !strncasecmp(class_name, "self", class_name_len)) {
+				class_name = scope->name;
+				class_name_len = scope->name_length;
+			} else if (class_name_len == sizeof("parent") - 1 && !strncasecmp(class_name, "parent", class_name_len) && scope->parent) {
+				class_name = scope->parent->name;
+				class_name_len = scope->parent->name_length;
+			}
+			signature->params[i].class_name     = pestrndup(class_name, class_name_len, 1);
+			signature->params[i].class_name_len = class_name_len;
+		}
+
+		default_value = zephir_ctor_default_value(constructor, i);
+		if (default_value) {
+			signature->params[i].default_value = zephir_zval_deep_copy(default_value, 1);
+		}
+	}
+
+	return signature;
+}
+
+/**
+ * Checks whether the files a signature was taken from are unchanged
+ */
+static int zephir_ctor_signature_is_fresh(zephir_ctor_signature *signature, zend_class_entry *ce TSRMLS_DC)
+{
+	zend_function *constructor = ce->constructor;
+	const char *file = zephir_class_file(ce), *ctor_file = NULL;
+	time_t mtime;
+
+	if (signature->epoch == zephir_cache_epoch) {
+		return 1;
+	}
+
+	if (constructor && constructor->type == ZEND_USER_FUNCTION) {
+		ctor_file = constructor->op_array.filename;
+	}
+
+	if ((file == NULL) != (signature->file == NULL) || (file && strcmp(file, signature->file))) {
+		return 0;
+	}
+
+	if ((ctor_file == NULL) != (signature->ctor_file == NULL) || (ctor_file && strcmp(ctor_file, signature->ctor_file))) {
+		return 0;
+	}
+
+	if (zephir_source_mtime(file, &mtime TSRMLS_CC) == FAILURE || mtime != signature->file_mtime) {
+		return 0;
+	}
+
+	if (zephir_source_mtime(ctor_file, &mtime TSRMLS_CC) == FAILURE || mtime != signature->ctor_mtime) {
+		return 0;
+	}
+
+	signature->epoch = zephir_cache_epoch;
+	return 1;
+}
+
+#endif
+
+/**
+ * Returns the constructor signature of a class as a list of [name, hasDefault, default, className] entries,
+ * where className is null when the parameter has no class type hint. The signature is kept in persistent memory.
+ * Returns false when the class cannot be instantiated directly or its signature cannot be cached,
+ * callers are expected to fall back to the Reflection API in that case
+ */
+int zephir_constructor_signature(zval *return_value, zval *class_name TSRMLS_DC)
+{
+#ifndef ZTS
+	zend_class_entry **ce_ptr, *ce, *scope;
+	zephir_ctor_signature *signature, **found;
+	zval *param, *default_value;
+	char *lc_name;
+	zend_uint i;
+
+	if (Z_TYPE_P(class_name) != IS_STRING || zend_lookup_class(Z_STRVAL_P(class_name), Z_STRLEN_P(class_name), &ce_ptr TSRMLS_CC) == FAILURE) {
+		ZVAL_FALSE(return_value);
+		return FAILURE;
+	}
+
+	ce = *ce_ptr;
+
+#ifdef ZEND_ACC_TRAIT
+	if (ce->ce_flags & (ZEND_ACC_INTERFACE | ZEND_ACC_IMPLICIT_ABSTRACT_CLASS | ZEND_ACC_EXPLICIT_ABSTRACT_CLASS | ZEND_ACC_TRAIT)) {
+#else
+	if (ce->ce_flags & (ZEND_ACC_INTERFACE | ZEND_ACC_IMPLICIT_ABSTRACT_CLASS | ZEND_ACC_EXPLICIT_ABSTRACT_CLASS)) {
+#endif
+		ZVAL_FALSE(return_value);
+		return FAILURE;
+	}
+
+	if (ce->constructor && !(ce->constructor->common.fn_flags & ZEND_ACC_PUBLIC)) {
+		ZVAL_FALSE(return_value);
+		return FAILURE;
+	}
+
+	if (!zephir_ctor_signatures) {
+		zephir_ctor_signatures = pemalloc(sizeof(HashTable), 1);
+		zend_hash_init(zephir_ctor_signatures, 32, NULL, zephir_ctor_signature_dtor, 1);
+	}
+
+	lc_name = zend_str_tolower_dup(ce->name, ce->name_length);
+
+	signature = NULL;
+	if (zend_hash_find(zephir_ctor_signatures, lc_name, ce->name_length + 1, (void **) &found) == SUCCESS) {
+		if (zephir_ctor_signature_is_fresh(*found, ce TSRMLS_CC)) {
+			signature = *found;
+		} else {
+			zend_hash_del(zephir_ctor_signatures, lc_name, ce->name_length + 1);
+		}
+	}
+
+	if (!signature) {
+		signature = zephir_ctor_signature_create(ce TSRMLS_CC);
+		if (!signature) {
+			efree(lc_name);
+			ZVAL_FALSE(return_value);
+			return FAILURE;
+		}
+		zend_hash_update(zephir_ctor_signatures, lc_name, ce->name_length + 1, &signature, sizeof(zephir_ctor_signature*), NULL);
+	}
+
+	efree(lc_name);
+
+	/* Class entries of user classes do not survive the request, the scope is never cached */
+	scope = ce->constructor ? ce->constructor->common.scope : ce;
+
+	array_init_size(return_value, signature->num_args);
+	for (i = 0; i < signature->num_args; ++i) {
+
+		MAKE_STD_ZVAL(param);
+		array_init_size(param, 4);
+		add_next_index_stringl(param, signature->params[i].name, signature->params[i].name_len, 1);
+
+		if (signature->params[i].default_value) {
+			default_value = zephir_zval_deep_copy(signature->params[i].default_value, 0);
+			switch (Z_TYPE_P(default_value) & IS_CONSTANT_TYPE_MASK) {
+				case IS_CONSTANT:
+				case IS_CONSTANT_ARRAY:
+					/* Constants are resolved in every request, they may have a different value */
+					zval_update_constant_ex(&default_value, 0, scope TSRMLS_CC);
+					break;
+			}
+			add_next_index_bool(param, 1);
+			add_next_index_zval(param, default_value);
+		} else {
+			add_next_index_bool(param, 0);
+			add_next_index_null(param);
+		}
+
+		if (signature->params[i].class_name) {
+			add_next_index_stringl(param, signature->params[i].class_name, signature->params[i].class_name_len, 1);
+		} else {
+			add_next_index_null(param);
+		}
+
+		add_next_index_zval(return_value, param);
+	}
+
+	return SUCCESS;
+#else
+	ZVAL_FALSE(return_value);
+	return FAILURE;
+#endif
+}
+
+/**
+ * Releases the constructor signatures, called at module shutdown through zephir_kernel_shutdown()
+ */
+void zephir_constructor_signatures_shutdown(void)
+{
+#ifndef ZTS
+	if (zephir_ctor_signatures) {
+		zend_hash_destroy(zephir_ctor_signatures);
+		pefree(zephir_ctor_signatures, 1);
+		zephir_ctor_signatures = NULL;
+	}
+#endif
+}
+
+/*
+ * Accessor tables
+ *----------------
+ *
+ * The getters and setters backing the magic properties of a class (getFoo()/setFoo() for "foo")
+ * are indexed once per class by the lowercase property name. Tables of internal classes are kept
+ * for the life of the process, the ones of user classes only for the request that built them,
+ * their class entries and methods being destroyed with it.
+ */
+#ifndef ZTS
+
+typedef struct _zephir_accessor_table {
+	zend_uint epoch;
+	HashTable accessors;
+} zephir_accessor_table;
+
+static HashTable *zephir_accessor_tables = NULL;
+static zend_uint zephir_accessor_tables_epoch = 0;
+
+static void zephir_accessor_table_dtor(void *data)
+{
+	zephir_accessor_table *table = *(zephir_accessor_table **) data;
+
+	zend_hash_destroy(&table->accessors);
+	pefree(table, 1);
+}
+
+static int zephir_accessor_table_is_stale(void *data TSRMLS_DC)
+{
+	zephir_accessor_table *table = *(zephir_accessor_table **) data;
+
+	return table->epoch != ZEPHIR_CACHE_EPOCH_PERSISTENT ? ZEND_HASH_APPLY_REMOVE : ZEND_HASH_APPLY_KEEP;
+}
+
+/**
+ * Indexes the non-private get*() and set*() methods of a class
+ */
+static zephir_accessor_table *zephir_accessor_table_create(zend_class_entry *ce)
+{
+	zephir_accessor_table *table;
+	zephir_accessor accessor, *found;
+	zend_function *func;
+	HashPosition pos;
+	char *key;
+	uint key_len;
+	ulong num_key;
+
+	table = pemalloc(sizeof(zephir_accessor_table), 1);
+	table->epoch = (ce->type == ZEND_INTERNAL_CLASS) ? ZEPHIR_CACHE_EPOCH_PERSISTENT : zephir_cache_epoch;
+	zend_hash_init(&table->accessors, 8, NULL, NULL, 1);
+
+	for (
+		zend_hash_internal_pointer_reset_ex(&ce->function_table, &pos);
+		zend_hash_get_current_data_ex(&ce->function_table, (void **) &func, &pos) == SUCCESS;
+		zend_hash_move_forward_ex(&ce->function_table, &pos)
+	) {
+		/* Keys of the function table are lowercase, key_len counts the trailing NUL */
+		if (zend_hash_get_current_key_ex(&ce->function_table, &key, &key_len, &num_key, 0, &pos) != HASH_KEY_IS_STRING || key_len <= 4) {
+			continue;
+		}
+
+		if ((key[0] != 'g' && key[0] != 's') || key[1] != 'e' || key[2] != 't') {
+			continue;
+		}
+
+		if (func->common.fn_flags & ZEND_ACC_PRIVATE) {
+			continue;
+		}
+
+		if (zend_hash_find(&table->accessors, key + 3, key_len - 3, (void **) &found) == SUCCESS) {
+			accessor = *found;
+		} else {
+			accessor.getter = NULL;
+			accessor.setter = NULL;
+		}
+
+		if (key[0] == 'g') {
+			accessor.getter = func;
+		} else {
+			accessor.setter = func;
+		}
+
+		zend_hash_update(&table->accessors, key + 3, key_len - 3, &accessor, sizeof(zephir_accessor), NULL);
+	}
+
+	return table;
+}
+
+#endif
+
+/**
+ * Finds the getter and the setter of a magic property, returns FAILURE if the class has neither
+ */
+int zephir_accessor_find(zephir_accessor *accessor, zend_class_entry *ce, const char *name, zend_uint name_length TSRMLS_DC)
+{
+	char stack_name[64], *lc_name;
+	int status = FAILURE;
+#ifndef ZTS
+	zephir_accessor_table *table, **found;
+	zephir_accessor *entry;
+#endif
+
+	lc_name = (name_length + 4 <= sizeof(stack_name)) ? stack_name : emalloc(name_length + 4);
+
+#ifndef ZTS
+	if (UNEXPECTED(!zephir_accessor_tables)) {
+		zephir_accessor_tables = pemalloc(sizeof(HashTable), 1);
+		zend_hash_init(zephir_accessor_tables, 32, NULL, zephir_accessor_table_dtor, 1);
+	}
+
+	/* The first lookup of a request drops the tables of the classes of the previous one */
+	if (UNEXPECTED(zephir_accessor_tables_epoch != zephir_cache_epoch)) {
+		zend_hash_apply(zephir_accessor_tables, zephir_accessor_table_is_stale TSRMLS_CC);
+		zephir_accessor_tables_epoch = zephir_cache_epoch;
+	}
+
+	if (zend_hash_index_find(zephir_accessor_tables, (ulong) ce, (void **) &found) == SUCCESS) {
+		table = *found;
+	} else {
+		table = zephir_accessor_table_create(ce);
+		zend_hash_index_update(zephir_accessor_tables, (ulong) ce, &table, sizeof(zephir_accessor_table *), NULL);
+	}
+
+	zend_str_tolower_copy(lc_name, name, name_length);
+	if (zend_hash_find(&table->accessors, lc_name, name_length + 1, (void **) &entry) == SUCCESS) {
+		*accessor = *entry;
+		status = SUCCESS;
+	}
+#else
+	accessor->getter = NULL;
+	accessor->setter = NULL;
+
+	memcpy(lc_name, "get", 3);
+	zend_str_tolower_copy(lc_name + 3, name, name_length);
+
+	if (zend_hash_find(&ce->function_table, lc_name, name_length + 4, (void **) &accessor->getter) == SUCCESS && (accessor->getter->common.fn_flags & ZEND_ACC_PRIVATE)) {
+		accessor->getter = NULL;
+	}
+
+	lc_name[0] = 's';
+	if (zend_hash_find(&ce->function_table, lc_name, name_length + 4, (void **) &accessor->setter) == SUCCESS && (accessor->setter->common.fn_flags & ZEND_ACC_PRIVATE)) {
+		accessor->setter = NULL;
+	}
+
+	status = (accessor->getter || accessor->setter) ? SUCCESS : FAILURE;
+#endif
+
+	if (lc_name != stack_name) {
+		efree(lc_name);
+	}
+
+	return status;
+}
+
+/**
+ * Releases the accessor tables, called at module shutdown through zephir_kernel_shutdown()
+ */
+void zephir_accessor_tables_shutdown(void)
+{
+#ifndef ZTS
+	if (zephir_accessor_tables) {
+		zend_hash_destroy(zephir_accessor_tables);
+		pefree(zephir_accessor_tables, 1);
+		zephir_accessor_tables = NULL;
+	}
+#endif
+}
+
+/**
+ * Calls an accessor found by zephir_accessor_find() on an object
+ */
+static int zephir_accessor_call(zend_function *func, zval *object, zval **retval_ptr, zend_uint param_count, zval ***params TSRMLS_DC)
+{
+	zend_fcall_info fci;
+	zend_fcall_info_cache fcc;
+
+	fci.size           = sizeof(fci);
+	fci.function_table = &Z_OBJCE_P(object)->function_table;
+	fci.function_name  = NULL;
+	fci.symbol_table   = NULL;
+	fci.object_ptr     = object;
+	fci.retval_ptr_ptr = retval_ptr;
+	fci.param_count    = param_count;
+	fci.params         = params;
+	fci.no_separation  = 1;
+
+	fcc.initialized      = 1;
+	fcc.function_handler = func;
+	fcc.calling_scope    = Z_OBJCE_P(object);
+	fcc.called_scope     = Z_OBJCE_P(object);
+	fcc.object_ptr       = object;
+
+	return zend_call_function(&fci, &fcc TSRMLS_CC);
+}
+
+/**
+ * Returns the ZEPHIR_ACCESSOR_* flags telling whether a magic property has a getter and/or a setter
+ */
+int zephir_accessor_flags(const zval *object, const zval *name TSRMLS_DC)
+{
+	zephir_accessor accessor;
+	int flags = 0;
+
+	if (Z_TYPE_P(object) != IS_OBJECT || Z_TYPE_P(name) != IS_STRING) {
+		return 0;
+	}
+
+	if (zephir_accessor_find(&accessor, Z_OBJCE_P(object), Z_STRVAL_P(name), Z_STRLEN_P(name) TSRMLS_CC) == SUCCESS) {
+		if (accessor.getter) {
+			flags |= ZEPHIR_ACCESSOR_GETTER;
+		}
+		if (accessor.setter) {
+			flags |= ZEPHIR_ACCESSOR_SETTER;
+		}
+	}
+
+	return flags;
+}
+
+/**
+ * Reads a magic property through its getter, returns 0 without touching result if there is no getter.
+ * result must have been released by the caller (see ZEPHIR_OBSERVE_OR_NULLIFY_PPZV)
+ */
+int zephir_accessor_get(zval **result, zval *object, const zval *name TSRMLS_DC)
+{
+	zephir_accessor accessor;
+	zval *retval_ptr = NULL;
+
+	if (Z_TYPE_P(object) != IS_OBJECT || Z_TYPE_P(name) != IS_STRING) {
+		return 0;
+	}
+
+	if (zephir_accessor_find(&accessor, Z_OBJCE_P(object), Z_STRVAL_P(name), Z_STRLEN_P(name) TSRMLS_CC) == FAILURE || !accessor.getter) {
+		return 0;
+	}
+
+	zephir_accessor_call(accessor.getter, object, &retval_ptr, 0, NULL TSRMLS_CC);
+
+	if (retval_ptr) {
+		*result = retval_ptr;
+	} else {
+		ALLOC_INIT_ZVAL(*result);
+	}
+
+	return 1;
+}
+
+/**
+ * Writes a magic property through its setter, returns 0 if there is no setter
+ */
+int zephir_accessor_set(zval *object, const zval *name, zval *value TSRMLS_DC)
+{
+	zephir_accessor accessor;
+	zval *retval_ptr = NULL, **params[1];
+
+	if (Z_TYPE_P(object) != IS_OBJECT || Z_TYPE_P(name) != IS_STRING) {
+		return 0;
+	}
+
+	if (zephir_accessor_find(&accessor, Z_OBJCE_P(object), Z_STRVAL_P(name), Z_STRLEN_P(name) TSRMLS_CC) == FAILURE || !accessor.setter) {
+		return 0;
+	}
+
+	params[0] = &value;
+	zephir_accessor_call(accessor.setter, object, &retval_ptr, 1, params TSRMLS_CC);
+
+	if (retval_ptr) {
+		zval_ptr_dtor(&retval_ptr);
+	}
+
+	return 1;
 }
 
 /**
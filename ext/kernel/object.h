@@ -60,6 +60,14 @@ int zephir_isset_property(zval *object, const char *property_name, unsigned int
 int zephir_isset_property_quick(zval *object, const char *property_name, unsigned int property_length, unsigned long hash TSRMLS_DC);
 int zephir_isset_property_zval(zval *object, const zval *property TSRMLS_DC);
 
+/** Inline cache of a property access site */
+typedef struct _zephir_property_ic {
+	zend_class_entry *ce;
+	const char *name;
+	zend_property_info *property_info;
+	zend_uint epoch;
+} zephir_property_ic;
+
 /** Reading properties */
 zval* zephir_fetch_property_this_quick(zval *object, const char *property_name, zend_uint property_length, ulong key, int silent TSRMLS_DC);
 int zephir_read_property(zval **result, zval *object, const char *property_name, zend_uint property_length, int silent TSRMLS_DC);
@@ -68,6 +76,10 @@ int zephir_return_property(zval *return_value, zval **return_value_ptr, zval *ob
 int zephir_return_property_quick(zval *return_value, zval **return_value_ptr, zval *object, char *property_name, unsigned int property_length, unsigned long key TSRMLS_DC);
 int zephir_fetch_property(zval **result, zval *object, const char *property_name, zend_uint property_length, int silent TSRMLS_DC);
 int zephir_fetch_property_zval(zval **result, zval *object, zval *property, int silent TSRMLS_DC);
+#if PHP_VERSION_ID >= 50400
+zval* zephir_fetch_property_this_ic(zephir_property_ic *ic, zval *object, const char *property_name, zend_uint property_length, int silent TSRMLS_DC);
+int zephir_read_property_ic(zephir_property_ic *ic, zval **result, zval *object, const char *property_name, zend_uint property_length, int silent TSRMLS_DC);
+#endif
 
 /** Updating properties */
 int zephir_update_property_this(zval *object, char *property_name, unsigned int property_length, zval *value TSRMLS_DC);
@@ -78,6 +90,9 @@ int zephir_update_property_null(zval *obj, char *property_name, unsigned int pro
 int zephir_update_property_zval(zval *obj, const char *property_name, unsigned int property_length, zval *value TSRMLS_DC);
 int zephir_update_property_zval_zval(zval *obj, zval *property, zval *value TSRMLS_DC);
 int zephir_update_property_empty_array(zend_class_entry *ce, zval *object, char *property, unsigned int property_length TSRMLS_DC);
+#if PHP_VERSION_ID >= 50400
+int zephir_update_property_this_ic(zephir_property_ic *ic, zval *object, const char *property_name, zend_uint property_length, zval *value TSRMLS_DC);
+#endif
 
 /** Updating array properties */
 int zephir_update_property_array(zval *object, const char *property, zend_uint property_length, const zval *index, zval *value TSRMLS_DC);
@@ -102,9 +117,45 @@ int zephir_read_class_property(zval **result, int type, const char *property, in
 zval* zephir_fetch_static_property_ce(zend_class_entry *ce, const char *property, int len TSRMLS_DC);
 int zephir_update_static_property_array_multi_ce(zend_class_entry *ce, const char *property, zend_uint property_length, zval **value TSRMLS_DC, const char *types, int types_length, int types_count, ...);
 
+/** In-place nested updates of array properties, keys are passed as zvals */
+#define ZEPHIR_ARRAY_PATH_UPDATE  0
+#define ZEPHIR_ARRAY_PATH_APPEND  1
+#define ZEPHIR_ARRAY_PATH_PREPEND 2
+#define ZEPHIR_ARRAY_PATH_UNSET   3
+
+int zephir_array_slot_apply(zval **slot, int operation, zval *value, int keys_count, ...);
+int zephir_property_array_update(zval *object, const char *property, zend_uint property_length, zval *value TSRMLS_DC, int keys_count, ...);
+int zephir_property_array_append(zval *object, const char *property, zend_uint property_length, zval *value TSRMLS_DC, int keys_count, ...);
+int zephir_property_array_prepend(zval *object, const char *property, zend_uint property_length, zval *value TSRMLS_DC, int keys_count, ...);
+int zephir_property_array_unset(zval *object, const char *property, zend_uint property_length TSRMLS_DC, int keys_count, ...);
+int zephir_static_property_array_update(zend_class_entry *ce, const char *property, zend_uint property_length, zval *value TSRMLS_DC, int keys_count, ...);
+int zephir_static_property_array_append(zend_class_entry *ce, const char *property, zend_uint property_length, zval *value TSRMLS_DC, int keys_count, ...);
+int zephir_static_property_array_prepend(zend_class_entry *ce, const char *property, zend_uint property_length, zval *value TSRMLS_DC, int keys_count, ...);
+int zephir_static_property_array_unset(zend_class_entry *ce, const char *property, zend_uint property_length TSRMLS_DC, int keys_count, ...);
+
 /** Create instances */
 int zephir_create_instance(zval *return_value, const zval *class_name TSRMLS_DC);
 int zephir_create_instance_params(zval *return_value, const zval *class_name, zval *params TSRMLS_DC);
+int zephir_create_instance_config(zval *return_value, const zval *class_name, zval *params, zval *properties TSRMLS_DC);
+
+/** Constructor signatures cached in persistent memory */
+int zephir_constructor_signature(zval *return_value, zval *class_name TSRMLS_DC);
+void zephir_constructor_signatures_shutdown(void);
+
+/** Getters and setters of magic properties, indexed once per class */
+#define ZEPHIR_ACCESSOR_GETTER 1
+#define ZEPHIR_ACCESSOR_SETTER 2
+
+typedef struct _zephir_accessor {
+	zend_function *getter;
+	zend_function *setter;
+} zephir_accessor;
+
+int zephir_accessor_find(zephir_accessor *accessor, zend_class_entry *ce, const char *name, zend_uint name_length TSRMLS_DC);
+int zephir_accessor_flags(const zval *object, const zval *name TSRMLS_DC);
+int zephir_accessor_get(zval **result, zval *object, const zval *name TSRMLS_DC);
+int zephir_accessor_set(zval *object, const zval *name, zval *value TSRMLS_DC);
+void zephir_accessor_tables_shutdown(void);
 
 /**
  * Reads a property from this_ptr (with pre-calculated key)
@@ -173,4 +224,66 @@ ZEPHIR_ATTR_NONNULL static inline zval* zephir_fetch_property_this(zval *object,
   return zephir_fetch_property_this_quick(object, property_name, property_length, zend_hash_func(property_name, property_length + 1), silent TSRMLS_CC);
 }
 
+#if PHP_VERSION_ID >= 50400
+
+/**
+ * Reads a property from this_ptr using the inline cache of the access site
+ * Variables must be defined in the class definition. This function ignores magic methods or dynamic properties
+ */
+ZEPHIR_ATTR_NONNULL static inline int zephir_read_property_this_ic(zephir_property_ic *ic, zval **result, zval *object, const char *property_name, zend_uint property_length, int silent TSRMLS_DC)
+{
+  zval *tmp = zephir_fetch_property_this_ic(ic, object, property_name, property_length, silent TSRMLS_CC);
+  if (EXPECTED(tmp != NULL)) {
+    *result = tmp;
+    Z_ADDREF_PP(result);
+    return SUCCESS;
+  }
+
+  ALLOC_INIT_ZVAL(*result);
+  return FAILURE;
+}
+
+ZEPHIR_ATTR_NONNULL static inline zval* zephir_fetch_nproperty_this_ic(zephir_property_ic *ic, zval *object, const char *property_name, zend_uint property_length, int silent TSRMLS_DC)
+{
+  zval *result = zephir_fetch_property_this_ic(ic, object, property_name, property_length, silent TSRMLS_CC);
+  return result ? result : EG(uninitialized_zval_ptr);
+}
+
+#endif
+
+/**
+ * Property accesses with a literal name get a static inline cache at the call site:
+ * the declaring slot is resolved once per class instead of on every access
+ */
+#if defined(__GNUC__) && !defined(ZTS) && PHP_VERSION_ID >= 50400 && !defined(ZEPHIR_KERNEL_OBJECT_C)
+
+#define ZEPHIR_PROPERTY_IC_NAME(name, ...) (name)
+
+#define zephir_read_property(result, object, ...) \
+	(__builtin_constant_p(ZEPHIR_PROPERTY_IC_NAME(__VA_ARGS__)) \
+		? ({ static zephir_property_ic ic_; zephir_read_property_ic(&ic_, result, object, __VA_ARGS__); }) \
+		: (zephir_read_property)(result, object, __VA_ARGS__))
+
+#define zephir_read_property_this(result, object, ...) \
+	(__builtin_constant_p(ZEPHIR_PROPERTY_IC_NAME(__VA_ARGS__)) \
+		? ({ static zephir_property_ic ic_; zephir_read_property_this_ic(&ic_, result, object, __VA_ARGS__); }) \
+		: (zephir_read_property_this)(result, object, __VA_ARGS__))
+
+#define zephir_fetch_property_this(object, ...) \
+	(__builtin_constant_p(ZEPHIR_PROPERTY_IC_NAME(__VA_ARGS__)) \
+		? ({ static zephir_property_ic ic_; zephir_fetch_property_this_ic(&ic_, object, __VA_ARGS__); }) \
+		: (zephir_fetch_property_this)(object, __VA_ARGS__))
+
+#define zephir_fetch_nproperty_this(object, ...) \
+	(__builtin_constant_p(ZEPHIR_PROPERTY_IC_NAME(__VA_ARGS__)) \
+		? ({ static zephir_property_ic ic_; zephir_fetch_nproperty_this_ic(&ic_, object, __VA_ARGS__); }) \
+		: (zephir_fetch_nproperty_this)(object, __VA_ARGS__))
+
+#define zephir_update_property_this(object, ...) \
+	(__builtin_constant_p(ZEPHIR_PROPERTY_IC_NAME(__VA_ARGS__)) \
+		? ({ static zephir_property_ic ic_; zephir_update_property_this_ic(&ic_, object, __VA_ARGS__); }) \
+		: (zephir_update_property_this)(object, __VA_ARGS__))
+
+#endif
+
 #endif
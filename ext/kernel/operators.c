@@ -224,6 +224,147 @@ void zephir_concat_self_char(zval **left, unsigned char right TSRMLS_DC) {
 	}
 }
 
+/** Operands concatenated without heap allocated descriptors */
+#define ZEPHIR_CONCAT_STACK_OPERANDS 8
+
+/** Printable view of a concatenation operand */
+typedef struct _zephir_concat_view {
+	const char *str;
+	zend_uint len;
+	int self;
+	int use_copy;
+	zval copy;
+	char buf[MAX_LENGTH_OF_LONG + 1];
+} zephir_concat_view;
+
+/**
+ * Resolves the printable representation of an operand; strings, integers,
+ * booleans and nulls never allocate
+ */
+static void zephir_concat_view_init(zephir_concat_view *view, const zephir_concat_operand *op, const zval *result, int self_var TSRMLS_DC){
+
+	zval *zv = op->zv;
+
+	view->self     = 0;
+	view->use_copy = 0;
+
+	if (!zv) {
+		view->str = op->str;
+		view->len = op->len;
+		return;
+	}
+
+	switch (Z_TYPE_P(zv)) {
+
+		case IS_STRING:
+			/* The result buffer may move when it is extended in place */
+			view->self = (self_var && zv == result);
+			view->str  = Z_STRVAL_P(zv);
+			view->len  = Z_STRLEN_P(zv);
+			break;
+
+		case IS_LONG:
+			view->len = (zend_uint) slprintf(view->buf, sizeof(view->buf), "%ld", Z_LVAL_P(zv));
+			view->str = view->buf;
+			break;
+
+		case IS_BOOL:
+			view->str = "1";
+			view->len = Z_BVAL_P(zv) ? 1 : 0;
+			break;
+
+		case IS_NULL:
+			view->str = "";
+			view->len = 0;
+			break;
+
+		default:
+			zend_make_printable_zval(zv, &view->copy, &view->use_copy);
+			if (view->use_copy) {
+				view->str = Z_STRVAL(view->copy);
+				view->len = Z_STRLEN(view->copy);
+			} else {
+				view->str = Z_STRVAL_P(zv);
+				view->len = Z_STRLEN_P(zv);
+			}
+			break;
+	}
+}
+
+/**
+ * Concatenates any number of operands: every operand is measured first and
+ * the result is written once into a buffer of the exact size
+ */
+void zephir_concat_n(zval **result, int self_var, zend_uint count, const zephir_concat_operand *ops TSRMLS_DC){
+
+	zephir_concat_view views_stack[ZEPHIR_CONCAT_STACK_OPERANDS], *views;
+	zval result_copy;
+	int use_copy = 0;
+	uint offset = 0, length = 0, i;
+	char *buf;
+
+	views = (count <= ZEPHIR_CONCAT_STACK_OPERANDS) ? views_stack : (zephir_concat_view *) emalloc(count * sizeof(zephir_concat_view));
+
+	if (self_var && Z_TYPE_PP(result) != IS_STRING) {
+		zend_make_printable_zval(*result, &result_copy, &use_copy);
+		if (use_copy) {
+			ZEPHIR_CPY_WRT_CTOR(*result, (&result_copy));
+		}
+	}
+
+	for (i = 0; i < count; ++i) {
+		zephir_concat_view_init(&views[i], &ops[i], *result, self_var TSRMLS_CC);
+		length += views[i].len;
+	}
+
+	if (self_var) {
+
+		offset = Z_STRLEN_PP(result);
+		length += offset;
+
+		if (IS_INTERNED(Z_STRVAL_PP(result))) {
+			buf = (char *) emalloc(length + 1);
+			memcpy(buf, Z_STRVAL_PP(result), offset);
+		} else {
+			buf = (char *) erealloc(Z_STRVAL_PP(result), length + 1);
+		}
+
+	} else {
+		buf = (char *) emalloc(length + 1);
+	}
+
+	ZEPHIR_KERNEL_STAT_INC(concat_allocs);
+
+	Z_STRVAL_PP(result) = buf;
+	buf += offset;
+
+	for (i = 0; i < count; ++i) {
+		if (views[i].self) {
+			/* The left side was extended in place, its original bytes are still at the start */
+			memcpy(buf, Z_STRVAL_PP(result), views[i].len);
+		} else {
+			memcpy(buf, views[i].str, views[i].len);
+		}
+		buf += views[i].len;
+
+		if (views[i].use_copy) {
+			zval_dtor(&views[i].copy);
+		}
+	}
+
+	Z_STRVAL_PP(result)[length] = 0;
+	Z_TYPE_PP(result) = IS_STRING;
+	Z_STRLEN_PP(result) = length;
+
+	if (views != views_stack) {
+		efree(views);
+	}
+
+	if (use_copy) {
+	   zval_dtor(&result_copy);
+	}
+}
+
 /**
  * Natural compare with string operandus on right
  */
@@ -98,6 +98,25 @@ void zephir_concat_self_str(zval **left, const char *right, int right_length TSR
 void zephir_concat_self_long(zval **left, const long right TSRMLS_DC);
 void zephir_concat_self_char(zval **left, unsigned char right TSRMLS_DC);
 
+/** Operand of an n-ary concatenation: either a C string or a zval */
+typedef struct _zephir_concat_operand {
+	const char *str;
+	zend_uint len;
+	zval *zv;
+} zephir_concat_operand;
+
+#define ZEPHIR_CONCAT_OP_S(op) { op, sizeof(op)-1, NULL }
+#define ZEPHIR_CONCAT_OP_V(op) { NULL, 0, op }
+
+/** Concatenates all the operands into result using a single allocation */
+#define ZEPHIR_CONCAT_N(result, self_var, ...) \
+	do { \
+		const zephir_concat_operand zephir_concat_ops_[] = { __VA_ARGS__ }; \
+		zephir_concat_n(&result, self_var, sizeof(zephir_concat_ops_) / sizeof(zephir_concat_operand), zephir_concat_ops_ TSRMLS_CC); \
+	} while (0)
+
+void zephir_concat_n(zval **result, int self_var, zend_uint count, const zephir_concat_operand *ops TSRMLS_DC);
+
 /** Strict comparing */
 int zephir_compare_strict_string(zval *op1, const char *op2, int op2_length);
 int zephir_compare_strict_long(zval *op1, long op2 TSRMLS_DC);
@@ -58,6 +58,436 @@
 #define PH_RANDOM_NUMERIC 3
 #define PH_RANDOM_NOZERO 4
 
+#ifdef ZEPHIR_STRING_SIMD
+#include <immintrin.h>
+#endif
+
+/** Default character set used by trim() */
+#define ZEPHIR_TRIM_DEFAULT_CHARS " \t\n\r\v\0"
+
+static int zephir_simd_level = -1;
+
+/**
+ * Returns the widest instruction set available to the string kernels,
+ * the CPU is only queried once
+ */
+int zephir_string_simd_level(void) {
+
+	if (unlikely(zephir_simd_level < 0)) {
+#ifdef ZEPHIR_STRING_SIMD
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2")) {
+			zephir_simd_level = ZEPHIR_SIMD_AVX2;
+		} else if (__builtin_cpu_supports("sse4.2")) {
+			zephir_simd_level = ZEPHIR_SIMD_SSE42;
+		} else {
+			zephir_simd_level = ZEPHIR_SIMD_NONE;
+		}
+#else
+		zephir_simd_level = ZEPHIR_SIMD_NONE;
+#endif
+	}
+
+	return zephir_simd_level;
+}
+
+#ifdef ZEPHIR_STRING_SIMD
+
+/**
+ * Substring search comparing the needle prefix against 16 haystack bytes at a time
+ */
+__attribute__((target("sse4.2")))
+static const char *zephir_memmem_sse42(const char *haystack, size_t haystack_len, const char *needle, size_t needle_len) {
+
+	char prefix[16] = { 0 };
+	size_t i = 0, last;
+	int prefix_len, idx;
+	__m128i pattern;
+
+	last = haystack_len - needle_len;
+	prefix_len = needle_len > 16 ? 16 : (int) needle_len;
+	memcpy(prefix, needle, prefix_len);
+	pattern = _mm_loadu_si128((const __m128i *) prefix);
+
+	while (i + 16 <= haystack_len) {
+
+		idx = _mm_cmpestri(pattern, prefix_len, _mm_loadu_si128((const __m128i *) (haystack + i)), 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ORDERED);
+		if (idx == 16) {
+			i += 16;
+			continue;
+		}
+
+		/* Candidates are reported in order, a partial match at the end of the block included */
+		if (i + idx > last) {
+			return NULL;
+		}
+
+		if (!memcmp(haystack + i + idx, needle, needle_len)) {
+			return haystack + i + idx;
+		}
+
+		i += idx + 1;
+	}
+
+	for (; i <= last; i++) {
+		if (!memcmp(haystack + i, needle, needle_len)) {
+			return haystack + i;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Substring search filtering 32 candidate positions at a time by the first and last needle bytes
+ */
+__attribute__((target("avx2")))
+static const char *zephir_memmem_avx2(const char *haystack, size_t haystack_len, const char *needle, size_t needle_len) {
+
+	size_t i = 0, last;
+	unsigned int mask, bit;
+	__m256i first, tail, block_first, block_tail;
+
+	last = haystack_len - needle_len;
+	first = _mm256_set1_epi8(needle[0]);
+	tail  = _mm256_set1_epi8(needle[needle_len - 1]);
+
+	for (; i + 32 <= last + 1; i += 32) {
+
+		block_first = _mm256_loadu_si256((const __m256i *) (haystack + i));
+		block_tail  = _mm256_loadu_si256((const __m256i *) (haystack + i + needle_len - 1));
+
+		mask = (unsigned int) _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(tail, block_tail)));
+		while (mask) {
+			bit = __builtin_ctz(mask);
+			if (!memcmp(haystack + i + bit + 1, needle + 1, needle_len - 2)) {
+				return haystack + i + bit;
+			}
+			mask &= mask - 1;
+		}
+	}
+
+	for (; i <= last; i++) {
+		if (haystack[i] == needle[0] && !memcmp(haystack + i + 1, needle + 1, needle_len - 1)) {
+			return haystack + i;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Returns the number of leading bytes contained in the character set
+ */
+__attribute__((target("sse4.2")))
+static size_t zephir_trim_left_sse42(const char *str, size_t len, const char *chars, int chars_len) {
+
+	char set[16] = { 0 };
+	size_t i = 0;
+	int idx;
+	__m128i pattern;
+
+	memcpy(set, chars, chars_len);
+	pattern = _mm_loadu_si128((const __m128i *) set);
+
+	for (; i + 16 <= len; i += 16) {
+		idx = _mm_cmpestri(pattern, chars_len, _mm_loadu_si128((const __m128i *) (str + i)), 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_NEGATIVE_POLARITY);
+		if (idx < 16) {
+			return i + idx;
+		}
+	}
+
+	while (i < len && memchr(chars, str[i], chars_len)) {
+		i++;
+	}
+
+	return i;
+}
+
+/**
+ * Returns the length of the string once the trailing bytes contained in the character set are removed
+ */
+__attribute__((target("sse4.2")))
+static size_t zephir_trim_right_sse42(const char *str, size_t len, const char *chars, int chars_len) {
+
+	char set[16] = { 0 };
+	int idx;
+	__m128i pattern;
+
+	memcpy(set, chars, chars_len);
+	pattern = _mm_loadu_si128((const __m128i *) set);
+
+	for (; len >= 16; len -= 16) {
+		idx = _mm_cmpestri(pattern, chars_len, _mm_loadu_si128((const __m128i *) (str + len - 16)), 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_NEGATIVE_POLARITY | _SIDD_MOST_SIGNIFICANT);
+		if (idx < 16) {
+			return len - 16 + idx + 1;
+		}
+	}
+
+	while (len > 0 && memchr(chars, str[len - 1], chars_len)) {
+		len--;
+	}
+
+	return len;
+}
+
+/**
+ * Copies lowercased bytes until a separator ('-' or '_') or a non-ASCII byte is found,
+ * returns the number of bytes copied
+ */
+__attribute__((target("sse4.2")))
+static size_t zephir_camelize_run_sse42(char *dst, const char *src, size_t len) {
+
+	size_t i = 0;
+	unsigned int stop;
+	__m128i block, upper;
+
+	for (; i + 16 <= len; i += 16) {
+
+		block = _mm_loadu_si128((const __m128i *) (src + i));
+		stop  = (unsigned int) (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('-')), _mm_cmpeq_epi8(block, _mm_set1_epi8('_')))) | _mm_movemask_epi8(block));
+
+		upper = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+		_mm_storeu_si128((__m128i *) (dst + i), _mm_or_si128(block, _mm_and_si128(upper, _mm_set1_epi8(0x20))));
+
+		if (stop) {
+			return i + __builtin_ctz(stop);
+		}
+	}
+
+	return i;
+}
+
+__attribute__((target("avx2")))
+static size_t zephir_camelize_run_avx2(char *dst, const char *src, size_t len) {
+
+	size_t i = 0;
+	unsigned int stop;
+	__m256i block, upper;
+
+	for (; i + 32 <= len; i += 32) {
+
+		block = _mm256_loadu_si256((const __m256i *) (src + i));
+		stop  = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('-')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('_'))), block));
+
+		upper = _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), block));
+		_mm256_storeu_si256((__m256i *) (dst + i), _mm256_or_si256(block, _mm256_and_si256(upper, _mm256_set1_epi8(0x20))));
+
+		if (stop) {
+			return i + __builtin_ctz(stop);
+		}
+	}
+
+	return i + zephir_camelize_run_sse42(dst + i, src + i, len - i);
+}
+
+/**
+ * Returns the position of the first uppercase ASCII letter or NUL byte
+ */
+__attribute__((target("sse4.2")))
+static size_t zephir_uncamelize_run_sse42(const char *str, size_t len) {
+
+	size_t i = 0;
+	unsigned int stop;
+	__m128i block;
+
+	for (; i + 16 <= len; i += 16) {
+		block = _mm_loadu_si128((const __m128i *) (str + i));
+		stop  = (unsigned int) _mm_movemask_epi8(_mm_or_si128(
+			_mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1))),
+			_mm_cmpeq_epi8(block, _mm_setzero_si128())
+		));
+		if (stop) {
+			return i + __builtin_ctz(stop);
+		}
+	}
+
+	for (; i < len; i++) {
+		if ((str[i] >= 'A' && str[i] <= 'Z') || str[i] == '\0') {
+			break;
+		}
+	}
+
+	return i;
+}
+
+__attribute__((target("avx2")))
+static size_t zephir_uncamelize_run_avx2(const char *str, size_t len) {
+
+	size_t i = 0;
+	unsigned int stop;
+	__m256i block;
+
+	for (; i + 32 <= len; i += 32) {
+		block = _mm256_loadu_si256((const __m256i *) (str + i));
+		stop  = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(
+			_mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), block)),
+			_mm256_cmpeq_epi8(block, _mm256_setzero_si256())
+		));
+		if (stop) {
+			return i + __builtin_ctz(stop);
+		}
+	}
+
+	return i + zephir_uncamelize_run_sse42(str + i, len - i);
+}
+
+
+/**
+ * Returns the length of the leading run of ASCII bytes not contained in the character set
+ */
+__attribute__((target("sse4.2")))
+static size_t zephir_ascii_span_sse42(const char *str, size_t len, const char *chars, int chars_len) {
+
+	char set[16] = { 0 };
+	size_t i = 0;
+	unsigned int stop;
+	__m128i pattern, block;
+
+	memcpy(set, chars, chars_len);
+	pattern = _mm_loadu_si128((const __m128i *) set);
+
+	for (; i + 16 <= len; i += 16) {
+		block = _mm_loadu_si128((const __m128i *) (str + i));
+		stop  = (unsigned int) (_mm_cvtsi128_si32(_mm_cmpestrm(pattern, chars_len, block, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK)) | _mm_movemask_epi8(block));
+		if (stop) {
+			return i + __builtin_ctz(stop);
+		}
+	}
+
+	for (; i < len; i++) {
+		if ((unsigned char) str[i] >= 0x80 || memchr(chars, str[i], chars_len)) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+__attribute__((target("avx2")))
+static size_t zephir_ascii_span_avx2(const char *str, size_t len, const char *chars, int chars_len) {
+
+	size_t i = 0;
+	unsigned int stop;
+	int j;
+	__m256i set[16], block, found;
+
+	for (j = 0; j < chars_len; j++) {
+		set[j] = _mm256_set1_epi8(chars[j]);
+	}
+
+	for (; i + 32 <= len; i += 32) {
+		block = found = _mm256_loadu_si256((const __m256i *) (str + i));
+		for (j = 0; j < chars_len; j++) {
+			found = _mm256_or_si256(found, _mm256_cmpeq_epi8(block, set[j]));
+		}
+		stop = (unsigned int) _mm256_movemask_epi8(found);
+		if (stop) {
+			return i + __builtin_ctz(stop);
+		}
+	}
+
+	return i + zephir_ascii_span_sse42(str + i, len - i, chars, chars_len);
+}
+#endif
+
+/**
+ * Finds the first occurrence of needle in haystack, dispatching to the widest kernel available
+ */
+static const char *zephir_memmem(const char *haystack, size_t haystack_len, const char *needle, size_t needle_len) {
+
+	if (unlikely(!needle_len)) {
+		return haystack;
+	}
+
+	if (needle_len > haystack_len) {
+		return NULL;
+	}
+
+	if (needle_len == 1) {
+		return memchr(haystack, needle[0], haystack_len);
+	}
+
+#ifdef ZEPHIR_STRING_SIMD
+	switch (zephir_string_simd_level()) {
+		case ZEPHIR_SIMD_AVX2:
+			return zephir_memmem_avx2(haystack, haystack_len, needle, needle_len);
+		case ZEPHIR_SIMD_SSE42:
+			return zephir_memmem_sse42(haystack, haystack_len, needle, needle_len);
+	}
+#endif
+
+	return php_memnstr((char *) haystack, (char *) needle, needle_len, (char *) haystack + haystack_len);
+}
+
+/**
+ * Copies lowercased bytes until a separator or a non-ASCII byte, the scalar fallback leaves the work to the caller
+ */
+static inline size_t zephir_camelize_run(char *dst, const char *src, size_t len) {
+
+#ifdef ZEPHIR_STRING_SIMD
+	switch (zephir_string_simd_level()) {
+		case ZEPHIR_SIMD_AVX2:
+			return zephir_camelize_run_avx2(dst, src, len);
+		case ZEPHIR_SIMD_SSE42:
+			return zephir_camelize_run_sse42(dst, src, len);
+	}
+#endif
+
+	return 0;
+}
+
+/**
+ * Returns the position of the first uppercase ASCII letter or NUL byte
+ */
+static inline size_t zephir_uncamelize_run(const char *str, size_t len) {
+
+	size_t i;
+
+#ifdef ZEPHIR_STRING_SIMD
+	switch (zephir_string_simd_level()) {
+		case ZEPHIR_SIMD_AVX2:
+			return zephir_uncamelize_run_avx2(str, len);
+		case ZEPHIR_SIMD_SSE42:
+			return zephir_uncamelize_run_sse42(str, len);
+	}
+#endif
+
+	for (i = 0; i < len; i++) {
+		if ((str[i] >= 'A' && str[i] <= 'Z') || str[i] == '\0') {
+			break;
+		}
+	}
+
+	return i;
+}
+
+/**
+ * Returns the length of the leading run of ASCII bytes not contained in chars,
+ * the character set cannot be wider than 16 bytes
+ */
+size_t zephir_ascii_span(const char *str, size_t len, const char *chars, int chars_len) {
+
+	size_t i;
+
+#ifdef ZEPHIR_STRING_SIMD
+	switch (zephir_string_simd_level()) {
+		case ZEPHIR_SIMD_AVX2:
+			return zephir_ascii_span_avx2(str, len, chars, chars_len);
+		case ZEPHIR_SIMD_SSE42:
+			return zephir_ascii_span_sse42(str, len, chars, chars_len);
+	}
+#endif
+
+	for (i = 0; i < len; i++) {
+		if ((unsigned char) str[i] >= 0x80 || memchr(chars, str[i], chars_len)) {
+			break;
+		}
+	}
+
+	return i;
+}
+
 /**
  * Fast call to php strlen
  */
@@ -256,8 +686,8 @@ void zephir_fast_join_str(zval *return_value, char *glue, unsigned int glue_leng
 void zephir_camelize(zval *return_value, const zval *str){
 
 	int i, len;
-	smart_str camelize_str = {0};
-	char *marker, ch;
+	size_t run;
+	char *marker, *buffer, *cursor, ch;
 
 	if (unlikely(Z_TYPE_P(str) != IS_STRING)) {
 		zend_error(E_WARNING, "Invalid arguments supplied for camelize()");
@@ -267,6 +697,13 @@ void zephir_camelize(zval *return_value, const zval *str){
 	marker = Z_STRVAL_P(str);
 	len    = Z_STRLEN_P(str);
 
+	if (!len) {
+		RETURN_EMPTY_STRING();
+	}
+
+	/* Separators are dropped so the result is never longer than the input */
+	buffer = cursor = emalloc(len + 1);
+
 	for (i = 0; i < len - 1; i++) {
 		ch = *marker;
 		if (i == 0 || ch == '-' || ch == '_') {
@@ -275,27 +712,30 @@ void zephir_camelize(zval *return_value, const zval *str){
 				marker++;
 			}
 
-			smart_str_appendc(&camelize_str, toupper(*marker));
+			*cursor++ = toupper(*marker);
 		}
 		else {
-			smart_str_appendc(&camelize_str, tolower(*marker));
+			run = zephir_camelize_run(cursor, marker, (len - 1) - i);
+			if (run) {
+				cursor += run;
+				marker += run;
+				i      += run - 1;
+				continue;
+			}
+
+			*cursor++ = tolower(*marker);
 		}
 
 		marker++;
 	}
 
 	if (likely(i == len - 1)) {
-		smart_str_appendc(&camelize_str, *marker);
+		*cursor++ = *marker;
 	}
 
-	smart_str_0(&camelize_str);
-
-	if (camelize_str.c) {
-		RETURN_STRINGL(camelize_str.c, camelize_str.len, 0);
-	} else {
-		RETURN_EMPTY_STRING();
-	}
+	*cursor = '\0';
 
+	RETURN_STRINGL(buffer, cursor - buffer, 0);
 }
 
 /**
@@ -303,9 +743,9 @@ void zephir_camelize(zval *return_value, const zval *str){
  */
 void zephir_uncamelize(zval *return_value, const zval *str){
 
-	unsigned int i;
-	smart_str uncamelize_str = {0};
-	char *marker, ch;
+	unsigned int i, len;
+	size_t run;
+	char *marker, *buffer, *cursor;
 
 	if (Z_TYPE_P(str) != IS_STRING) {
 		zend_error(E_WARNING, "Invalid arguments supplied for camelize()");
@@ -313,28 +753,33 @@ void zephir_uncamelize(zval *return_value, const zval *str){
 	}
 
 	marker = Z_STRVAL_P(str);
-	for (i = 0; i < Z_STRLEN_P(str); i++) {
-		ch = *marker;
-		if (ch == '\0') {
+	len    = Z_STRLEN_P(str);
+
+	/* Every uppercase letter may add an underscore */
+	buffer = cursor = safe_emalloc(len, 2, 1);
+
+	i = 0;
+	while (i < len) {
+
+		run = zephir_uncamelize_run(marker + i, len - i);
+		memcpy(cursor, marker + i, run);
+		cursor += run;
+		i      += run;
+
+		if (i == len || marker[i] == '\0') {
 			break;
 		}
-		if (ch >= 'A' && ch <= 'Z') {
-			if (i > 0) {
-				smart_str_appendc(&uncamelize_str, '_');
-			}
-			smart_str_appendc(&uncamelize_str, (*marker) + 32);
-		} else {
-			smart_str_appendc(&uncamelize_str, (*marker));
+
+		if (i > 0) {
+			*cursor++ = '_';
 		}
-		marker++;
+		*cursor++ = marker[i] + 32;
+		i++;
 	}
-	smart_str_0(&uncamelize_str);
 
-	if (uncamelize_str.c) {
-		RETURN_STRINGL(uncamelize_str.c, uncamelize_str.len, 0);
-	} else {
-		RETURN_EMPTY_STRING();
-	}
+	*cursor = '\0';
+
+	RETURN_STRINGL(buffer, cursor - buffer, 0);
 }
 
 /**
@@ -384,7 +829,7 @@ int zephir_memnstr(const zval *haystack, const zval *needle ZEPHIR_DEBUG_PARAMS)
 	}
 
 	if (Z_STRLEN_P(haystack) >= Z_STRLEN_P(needle)) {
-		return php_memnstr(Z_STRVAL_P(haystack), Z_STRVAL_P(needle), Z_STRLEN_P(needle), Z_STRVAL_P(haystack) + Z_STRLEN_P(haystack)) ? 1 : 0;
+		return zephir_memmem(Z_STRVAL_P(haystack), Z_STRLEN_P(haystack), Z_STRVAL_P(needle), Z_STRLEN_P(needle)) ? 1 : 0;
 	}
 
 	return 0;
@@ -405,7 +850,7 @@ int zephir_memnstr_str(const zval *haystack, char *needle, unsigned int needle_l
 	}
 
 	if (Z_STRLEN_P(haystack) >= needle_length) {
-		return php_memnstr(Z_STRVAL_P(haystack), needle, needle_length, Z_STRVAL_P(haystack) + Z_STRLEN_P(haystack)) ? 1 : 0;
+		return zephir_memmem(Z_STRVAL_P(haystack), Z_STRLEN_P(haystack), needle, needle_length) ? 1 : 0;
 	}
 
 	return 0;
@@ -416,7 +861,7 @@ int zephir_memnstr_str(const zval *haystack, char *needle, unsigned int needle_l
  */
 void zephir_fast_strpos(zval *return_value, const zval *haystack, const zval *needle, unsigned int offset) {
 
-	char *found = NULL;
+	const char *found = NULL;
 
 	if (unlikely(Z_TYPE_P(haystack) != IS_STRING || Z_TYPE_P(needle) != IS_STRING)) {
 		ZVAL_NULL(return_value);
@@ -436,7 +881,7 @@ void zephir_fast_strpos(zval *return_value, const zval *haystack, const zval *ne
 		return;
 	}
 
-	found = php_memnstr(Z_STRVAL_P(haystack)+offset, Z_STRVAL_P(needle), Z_STRLEN_P(needle), Z_STRVAL_P(haystack) + Z_STRLEN_P(haystack));
+	found = zephir_memmem(Z_STRVAL_P(haystack) + offset, Z_STRLEN_P(haystack) - offset, Z_STRVAL_P(needle), Z_STRLEN_P(needle));
 
 	if (found) {
 		ZVAL_LONG(return_value, found-Z_STRVAL_P(haystack));
@@ -451,7 +896,7 @@ void zephir_fast_strpos(zval *return_value, const zval *haystack, const zval *ne
  */
 void zephir_fast_strpos_str(zval *return_value, const zval *haystack, char *needle, unsigned int needle_length) {
 
-	char *found = NULL;
+	const char *found = NULL;
 
 	if (unlikely(Z_TYPE_P(haystack) != IS_STRING)) {
 		ZVAL_NULL(return_value);
@@ -459,7 +904,7 @@ void zephir_fast_strpos_str(zval *return_value, const zval *haystack, char *need
 		return;
 	}
 
-	found = php_memnstr(Z_STRVAL_P(haystack), needle, needle_length, Z_STRVAL_P(haystack) + Z_STRLEN_P(haystack));
+	found = zephir_memmem(Z_STRVAL_P(haystack), Z_STRLEN_P(haystack), needle, needle_length);
 
 	if (found) {
 		ZVAL_LONG(return_value, found-Z_STRVAL_P(haystack));
@@ -474,8 +919,9 @@ void zephir_fast_strpos_str(zval *return_value, const zval *haystack, char *need
  */
 void zephir_fast_stripos_str(zval *return_value, zval *haystack, char *needle, unsigned int needle_length) {
 
-	char *found = NULL;
+	const char *found = NULL;
 	char *needle_dup, *haystack_dup;
+	long position = 0;
 
 	if (unlikely(Z_TYPE_P(haystack) != IS_STRING)) {
 		ZVAL_NULL(return_value);
@@ -489,13 +935,16 @@ void zephir_fast_stripos_str(zval *return_value, zval *haystack, char *needle, u
 	needle_dup = estrndup(needle, needle_length);
 	php_strtolower(needle_dup, needle_length);
 
-	found = php_memnstr(haystack_dup, needle, needle_length, haystack_dup + Z_STRLEN_P(haystack));
+	found = zephir_memmem(haystack_dup, Z_STRLEN_P(haystack), needle_dup, needle_length);
+	if (found) {
+		position = found - haystack_dup;
+	}
 
 	efree(haystack_dup);
 	efree(needle_dup);
 
 	if (found) {
-		ZVAL_LONG(return_value, found-Z_STRVAL_P(haystack));
+		ZVAL_LONG(return_value, position);
 	} else {
 		ZVAL_BOOL(return_value, 0);
 	}
@@ -503,6 +952,44 @@ void zephir_fast_stripos_str(zval *return_value, zval *haystack, char *needle, u
 }
 
 
+/**
+ * Replaces every occurrence of search in subject, counting the matches first
+ * so the result is allocated once
+ */
+static void zephir_str_replace_simd(zval *return_value, const char *subject, size_t subject_len, const char *search, size_t search_len, const char *replace, size_t replace_len) {
+
+	const char *found, *marker, *end = subject + subject_len;
+	size_t count = 0, length;
+	char *buffer, *cursor;
+
+	found = zephir_memmem(subject, subject_len, search, search_len);
+	if (!found) {
+		ZVAL_STRINGL(return_value, subject, subject_len, 1);
+		return;
+	}
+
+	for (marker = found; marker; marker = zephir_memmem(marker, end - marker, search, search_len)) {
+		count++;
+		marker += search_len;
+	}
+
+	length = subject_len - count * search_len + count * replace_len;
+	buffer = cursor = safe_emalloc(length, 1, 1);
+
+	for (marker = subject; found; found = zephir_memmem(marker, end - marker, search, search_len)) {
+		memcpy(cursor, marker, found - marker);
+		cursor += found - marker;
+		memcpy(cursor, replace, replace_len);
+		cursor += replace_len;
+		marker = found + search_len;
+	}
+
+	memcpy(cursor, marker, end - marker);
+	buffer[length] = '\0';
+
+	ZVAL_STRINGL(return_value, buffer, length, 0);
+}
+
 /**
  * Immediate function resolution for str_replace function
  */
@@ -517,6 +1004,11 @@ void zephir_fast_str_replace(zval *return_value, zval *search, zval *replace, zv
 		return;
 	}
 
+	if (Z_STRLEN_P(subject) == 0) {
+		ZVAL_STRINGL(return_value, "", 0, 1);
+		return;
+	}
+
 	if (Z_TYPE_P(replace) != IS_STRING) {
 		zend_make_printable_zval(replace, &replace_copy, &copy_replace);
 		if (copy_replace) {
@@ -531,28 +1023,25 @@ void zephir_fast_str_replace(zval *return_value, zval *search, zval *replace, zv
 		}
 	}
 
-	Z_TYPE_P(return_value) = IS_STRING;
-	if (Z_STRLEN_P(subject) == 0) {
-		ZVAL_STRINGL(return_value, "", 0, 1);
-		return;
-	}
-
-	if (Z_STRLEN_P(search) == 1) {
-		php_char_to_str_ex(Z_STRVAL_P(subject),
-			Z_STRLEN_P(subject),
-			Z_STRVAL_P(search)[0],
-			Z_STRVAL_P(replace),
-			Z_STRLEN_P(replace),
-			return_value,
-			1,
-			NULL);
+	if (Z_STRLEN_P(search) == 0) {
+		MAKE_COPY_ZVAL(&subject, return_value);
+	} else if (zephir_string_simd_level() != ZEPHIR_SIMD_NONE) {
+		zephir_str_replace_simd(return_value, Z_STRVAL_P(subject), Z_STRLEN_P(subject), Z_STRVAL_P(search), Z_STRLEN_P(search), Z_STRVAL_P(replace), Z_STRLEN_P(replace));
 	} else {
-		if (Z_STRLEN_P(search) > 1) {
+		Z_TYPE_P(return_value) = IS_STRING;
+		if (Z_STRLEN_P(search) == 1) {
+			php_char_to_str_ex(Z_STRVAL_P(subject),
+				Z_STRLEN_P(subject),
+				Z_STRVAL_P(search)[0],
+				Z_STRVAL_P(replace),
+				Z_STRLEN_P(replace),
+				return_value,
+				1,
+				NULL);
+		} else {
 			Z_STRVAL_P(return_value) = php_str_to_str_ex(Z_STRVAL_P(subject), Z_STRLEN_P(subject),
 				Z_STRVAL_P(search), Z_STRLEN_P(search),
 				Z_STRVAL_P(replace), Z_STRLEN_P(replace), &Z_STRLEN_P(return_value), 1, NULL);
-		} else {
-			MAKE_COPY_ZVAL(&subject, return_value);
 		}
 	}
 
@@ -580,11 +1069,44 @@ void zephir_fast_trim(zval *return_value, zval *str, zval *charlist, int where T
 			str = &copy;
 		}
 	}
+
+#ifdef ZEPHIR_STRING_SIMD
+	if (zephir_string_simd_level() != ZEPHIR_SIMD_NONE) {
+
+		const char *chars = ZEPHIR_TRIM_DEFAULT_CHARS;
+		int chars_len = sizeof(ZEPHIR_TRIM_DEFAULT_CHARS) - 1;
+		size_t start = 0, end = Z_STRLEN_P(str);
+
 		if (charlist && Z_TYPE_P(charlist) == IS_STRING) {
-			php_trim(Z_STRVAL_P(str), Z_STRLEN_P(str), Z_STRVAL_P(charlist), Z_STRLEN_P(charlist), return_value, where TSRMLS_CC);
-		} else {
-			php_trim(Z_STRVAL_P(str), Z_STRLEN_P(str), NULL, 0, return_value, where TSRMLS_CC);
+			chars     = Z_STRVAL_P(charlist);
+			chars_len = Z_STRLEN_P(charlist);
+		}
+
+		/* Character ranges ("a..z") and sets wider than a vector are left to php_trim */
+		if (chars_len > 0 && chars_len <= 16 && !zephir_memmem(chars, chars_len, "..", 2)) {
+
+			if (where & ZEPHIR_TRIM_LEFT) {
+				start = zephir_trim_left_sse42(Z_STRVAL_P(str), end, chars, chars_len);
+			}
+			if (where & ZEPHIR_TRIM_RIGHT) {
+				end = start + zephir_trim_right_sse42(Z_STRVAL_P(str) + start, end - start, chars, chars_len);
+			}
+
+			ZVAL_STRINGL(return_value, Z_STRVAL_P(str) + start, end - start, 1);
+
+			if (use_copy) {
+				zval_dtor(&copy);
+			}
+			return;
 		}
+	}
+#endif
+
+	if (charlist && Z_TYPE_P(charlist) == IS_STRING) {
+		php_trim(Z_STRVAL_P(str), Z_STRLEN_P(str), Z_STRVAL_P(charlist), Z_STRLEN_P(charlist), return_value, where TSRMLS_CC);
+	} else {
+		php_trim(Z_STRVAL_P(str), Z_STRLEN_P(str), NULL, 0, return_value, where TSRMLS_CC);
+	}
 
 	if (use_copy) {
 		zval_dtor(&copy);
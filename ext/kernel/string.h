@@ -27,6 +27,18 @@
 #define ZEPHIR_TRIM_RIGHT 2
 #define ZEPHIR_TRIM_BOTH  3
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define ZEPHIR_STRING_SIMD 1
+#endif
+
+#define ZEPHIR_SIMD_NONE  0
+#define ZEPHIR_SIMD_SSE42 1
+#define ZEPHIR_SIMD_AVX2  2
+
+/** Instruction set used by the string kernels */
+int zephir_string_simd_level(void);
+size_t zephir_ascii_span(const char *str, size_t len, const char *chars, int chars_len);
+
 /** Fast char position */
 int zephir_memnstr(const zval *haystack, const zval *needle ZEPHIR_DEBUG_PARAMS);
 int zephir_memnstr_str(const zval *haystack, char *needle, unsigned int needle_length ZEPHIR_DEBUG_PARAMS);
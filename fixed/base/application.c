@@ -285,7 +285,7 @@ PHP_METHOD(yii_base_Application, preInit) {
 		ZEPHIR_INIT_VAR(_0);
 		object_init_ex(_0, yii_base_invalidconfigexception_ce);
 		ZEPHIR_INIT_VAR(_1);
-		ZEPHIR_CONCAT_SSSSS(_1, "The ", "\"", "id", "\"", " configuration for the Application is required.");
+		ZEPHIR_CONCAT_N(_1, 0, ZEPHIR_CONCAT_OP_S("The "), ZEPHIR_CONCAT_OP_S("\""), ZEPHIR_CONCAT_OP_S("id"), ZEPHIR_CONCAT_OP_S("\""), ZEPHIR_CONCAT_OP_S(" configuration for the Application is required."));
 		ZEPHIR_CALL_METHOD(NULL, _0, "__construct", NULL, _1);
 		zephir_check_call_status();
 		zephir_throw_exception_debug(_0, "yii/base/Application.zep", 207 TSRMLS_CC);
@@ -301,7 +301,7 @@ PHP_METHOD(yii_base_Application, preInit) {
 		ZEPHIR_INIT_LNVAR(_0);
 		object_init_ex(_0, yii_base_invalidconfigexception_ce);
 		ZEPHIR_INIT_LNVAR(_1);
-		ZEPHIR_CONCAT_SSSSS(_1, "The ", "\"", "basePath", "\"", " configuration for the Application is required.");
+		ZEPHIR_CONCAT_N(_1, 0, ZEPHIR_CONCAT_OP_S("The "), ZEPHIR_CONCAT_OP_S("\""), ZEPHIR_CONCAT_OP_S("basePath"), ZEPHIR_CONCAT_OP_S("\""), ZEPHIR_CONCAT_OP_S(" configuration for the Application is required."));
 		ZEPHIR_CALL_METHOD(NULL, _0, "__construct", NULL, _1);
 		zephir_check_call_status();
 		zephir_throw_exception_debug(_0, "yii/base/Application.zep", 213 TSRMLS_CC);
@@ -725,7 +725,7 @@ PHP_METHOD(yii_base_Application, getRuntimePath) {
 		ZEPHIR_CALL_METHOD(&_1, this_ptr, "getbasepath",  NULL);
 		zephir_check_call_status();
 		ZEPHIR_INIT_VAR(_2);
-		ZEPHIR_CONCAT_VSS(_2, _1, "/", "runtime");
+		ZEPHIR_CONCAT_N(_2, 0, ZEPHIR_CONCAT_OP_V(_1), ZEPHIR_CONCAT_OP_S("/"), ZEPHIR_CONCAT_OP_S("runtime"));
 		ZEPHIR_CALL_METHOD(NULL, this_ptr, "setruntimepath", NULL, _2);
 		zephir_check_call_status();
 	}
@@ -778,7 +778,7 @@ PHP_METHOD(yii_base_Application, getVendorPath) {
 		ZEPHIR_CALL_METHOD(&_1, this_ptr, "getbasepath",  NULL);
 		zephir_check_call_status();
 		ZEPHIR_INIT_VAR(_2);
-		ZEPHIR_CONCAT_VSS(_2, _1, "/", "vendor");
+		ZEPHIR_CONCAT_N(_2, 0, ZEPHIR_CONCAT_OP_V(_1), ZEPHIR_CONCAT_OP_S("/"), ZEPHIR_CONCAT_OP_S("vendor"));
 		ZEPHIR_CALL_METHOD(NULL, this_ptr, "setvendorpath", NULL, _2);
 		zephir_check_call_status();
 	}
@@ -0,0 +1,1064 @@
+
+#ifdef HAVE_CONFIG_H
+#include "../../ext_config.h"
+#endif
+
+#include <php.h>
+#include "../../php_ext.h"
+#include "../../ext.h"
+
+#include <Zend/zend_objects.h>
+#include <Zend/zend_object_handlers.h>
+
+#include "kernel/main.h"
+#include "kernel/fcall.h"
+#include "kernel/object.h"
+#include "kernel/array.h"
+
+
+/**
+ * @link http://www.yiiframework.com/
+ * @copyright Copyright (c) 2008 Yii Software LLC
+ * @license http://www.yiiframework.com/license/
+ */
+/**
+ * ComponentStorageInterface gives a [[Component]] native storage for its event handlers and behaviors.
+ *
+ * Every class implementing the interface, including the classes inheriting it, is created with an object
+ * structure holding the event handlers and the behaviors next to the properties. Both stay NULL until they
+ * are used, even once the behaviors are ensured, so a component without events or behaviors costs two
+ * pointers, and telling whether there is anything to trigger or to ensure takes no property lookup.
+ *
+ * The component methods reach the storage through the `component_*` optimizers; cloning starts with an
+ * empty storage, as [[Component::__clone()]] always did.
+ *
+ * The storage also remembers which behavior provides a method or a property once a behavior was asked
+ * for it, so the magic methods do not query every behavior on each call. The answers are forgotten
+ * whenever a behavior is attached or detached.
+ *
+ * The handlers of an event are kept in a native list, with room at both ends so that prepending a handler
+ * is as cheap as appending one. Callables are resolved once, when they are attached, and [[Component::trigger()]]
+ * calls them directly. A trigger works on the handlers attached when it started, whatever they do meanwhile.
+ *
+ * @since 2.0
+ */
+
+/**
+ * A handler attached to an event, with its callable resolved when it was attached
+ */
+typedef struct _yii_base_componentstorage_handler {
+	zval *callable;
+	zval *data;
+	/* not initialized when the callable is resolved on each call */
+	zend_fcall_info_cache fcc;
+} yii_base_componentstorage_handler;
+
+/**
+ * The handlers attached to an event, from entries[start] on
+ */
+typedef struct _yii_base_componentstorage_list {
+	yii_base_componentstorage_handler *entries;
+	zend_uint start;
+	zend_uint count;
+	zend_uint size;
+	/* the component and the triggers iterating over the list */
+	zend_uint refcount;
+} yii_base_componentstorage_list;
+
+typedef struct _yii_base_componentstorage {
+	zend_object std;
+	/* event name => yii_base_componentstorage_list *, NULL until the first on() */
+	HashTable *events;
+	/* behaviors are scanned by the garbage collector along with the handlers */
+	zval *behaviors;
+	/* whether the declared behaviors were attached, the table is only created for the first behavior */
+	zend_bool ensured;
+	zval **gc_table;
+	int gc_size;
+	/* member => yii_base_componentstorage_target, NULL until a behavior member is looked up */
+	HashTable *targets;
+	zend_uint generation;
+} yii_base_componentstorage;
+
+/**
+ * The behavior providing a member. The behavior is not referenced: the behaviors table holds it
+ * as long as the entry lives, since the entries are dropped along with any change of the table
+ */
+typedef struct _yii_base_componentstorage_target {
+	zval *behavior;
+	/* the public method to call directly, NULL to go through the callable */
+	zend_function *method;
+} yii_base_componentstorage_target;
+
+/* Methods asking a behavior whether it provides a member, by YII_COMPONENT_* kind */
+static const char *yii_base_componentstorage_checks[] = { "hasmethod", "cangetproperty", "cansetproperty" };
+
+zend_class_entry *yii_base_componentstorageinterface_ce;
+
+static zend_object_handlers yii_base_componentstorage_handlers;
+
+/**
+ * Returns the storage of a component, NULL if the object was not created with one
+ */
+static inline yii_base_componentstorage *yii_base_componentstorage_fetch(const zval *object TSRMLS_DC)
+{
+	if (UNEXPECTED(Z_TYPE_P(object) != IS_OBJECT) || UNEXPECTED(Z_OBJ_HT_P(object)->clone_obj != yii_base_componentstorage_clone_obj)) {
+		return NULL;
+	}
+
+	return (yii_base_componentstorage *) zend_object_store_get_object((zval *) object TSRMLS_CC);
+}
+
+/**
+ * Returns the storage of a component about to be modified
+ */
+static yii_base_componentstorage *yii_base_componentstorage_fetch_write(const zval *object TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch(object TSRMLS_CC);
+
+	if (UNEXPECTED(!storage)) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "The object has no component storage");
+	}
+
+	return storage;
+}
+
+/**
+ * Drops the behavior members looked up so far
+ */
+static void yii_base_componentstorage_forget(yii_base_componentstorage *storage)
+{
+	storage->generation++;
+
+	if (storage->targets) {
+		zend_hash_destroy(storage->targets);
+		FREE_HASHTABLE(storage->targets);
+		storage->targets = NULL;
+	}
+}
+
+static void yii_base_componentstorage_unlisten(yii_base_componentstorage *storage TSRMLS_DC);
+
+/**
+ * Runs the destructor, then takes the handlers out of the counts of Event::$_listeners.
+ * Destructors run before the class statics are cleaned up, on shutdown too, which free_storage cannot rely on
+ */
+static void yii_base_componentstorage_destroy_object(void *object, zend_object_handle handle TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = (yii_base_componentstorage *) object;
+
+	zend_objects_destroy_object(&storage->std, handle TSRMLS_CC);
+
+	/* The handlers go along with the counts, the object is not to trigger anything anymore */
+	if (storage->events) {
+		yii_base_componentstorage_unlisten(storage TSRMLS_CC);
+		zend_hash_destroy(storage->events);
+		FREE_HASHTABLE(storage->events);
+		storage->events = NULL;
+	}
+}
+
+static void yii_base_componentstorage_free_storage(void *object TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = (yii_base_componentstorage *) object;
+
+	zend_object_std_dtor(&storage->std TSRMLS_CC);
+	yii_base_componentstorage_forget(storage);
+
+	if (storage->events) {
+		zend_hash_destroy(storage->events);
+		FREE_HASHTABLE(storage->events);
+	}
+	if (storage->behaviors) {
+		zval_ptr_dtor(&storage->behaviors);
+	}
+	if (storage->gc_table) {
+		efree(storage->gc_table);
+	}
+
+	efree(storage);
+}
+
+/**
+ * Creates a component with the given handlers, for the classes adding handlers of their own
+ */
+zend_object_value yii_base_componentstorage_create(zend_class_entry *ce, zend_object_handlers *handlers TSRMLS_DC)
+{
+	zend_object_value retval;
+	yii_base_componentstorage *storage = ecalloc(1, sizeof(yii_base_componentstorage));
+
+	zend_object_std_init(&storage->std, ce TSRMLS_CC);
+#if PHP_VERSION_ID >= 50400
+	object_properties_init(&storage->std, ce);
+#else
+	{
+		zval *tmp;
+		zend_hash_copy(storage->std.properties, &ce->default_properties, (copy_ctor_func_t) zval_add_ref, (void *) &tmp, sizeof(zval *));
+	}
+#endif
+
+	retval.handle = zend_objects_store_put(storage, yii_base_componentstorage_destroy_object, yii_base_componentstorage_free_storage, NULL TSRMLS_CC);
+	retval.handlers = handlers;
+
+	return retval;
+}
+
+zend_object_value yii_base_componentstorage_create_object(zend_class_entry *ce TSRMLS_DC)
+{
+	return yii_base_componentstorage_create(ce, &yii_base_componentstorage_handlers TSRMLS_CC);
+}
+
+/**
+ * Clones the properties only: the handlers and behaviors belong to the original component
+ */
+zend_object_value yii_base_componentstorage_clone_obj(zval *object TSRMLS_DC)
+{
+	zend_object_value retval;
+	zend_object *old_object = zend_objects_get_address(object TSRMLS_CC);
+	yii_base_componentstorage *storage;
+
+	retval = yii_base_componentstorage_create(old_object->ce, Z_OBJ_HT_P(object) TSRMLS_CC);
+	storage = (yii_base_componentstorage *) zend_object_store_get_object_by_handle(retval.handle TSRMLS_CC);
+
+	zend_objects_clone_members(&storage->std, retval, old_object, Z_OBJ_HANDLE_P(object) TSRMLS_CC);
+
+	return retval;
+}
+
+/**
+ * Builds the `[name => [[handler, data], ...]]` array the handlers used to be stored in
+ */
+static zval *yii_base_componentstorage_events_array(yii_base_componentstorage *storage TSRMLS_DC)
+{
+	yii_base_componentstorage_list **list;
+	HashPosition pos;
+	zval *events, *handlers, *pair;
+	char *name;
+	uint name_len;
+	ulong index;
+	zend_uint i;
+
+	MAKE_STD_ZVAL(events);
+	array_init(events);
+
+	for (zend_hash_internal_pointer_reset_ex(storage->events, &pos);
+		zend_hash_get_current_data_ex(storage->events, (void **) &list, &pos) == SUCCESS;
+		zend_hash_move_forward_ex(storage->events, &pos)) {
+
+		if ((*list)->count == 0) {
+			continue;
+		}
+
+		MAKE_STD_ZVAL(handlers);
+		array_init_size(handlers, (*list)->count);
+		for (i = (*list)->start; i < (*list)->start + (*list)->count; i++) {
+			MAKE_STD_ZVAL(pair);
+			array_init_size(pair, 2);
+			Z_ADDREF_P((*list)->entries[i].callable);
+			add_next_index_zval(pair, (*list)->entries[i].callable);
+			Z_ADDREF_P((*list)->entries[i].data);
+			add_next_index_zval(pair, (*list)->entries[i].data);
+			add_next_index_zval(handlers, pair);
+		}
+
+		if (zend_hash_get_current_key_ex(storage->events, &name, &name_len, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+			add_assoc_zval_ex(events, name, name_len, handlers);
+		} else {
+			add_index_zval(events, index, handlers);
+		}
+	}
+
+	return events;
+}
+
+/**
+ * Shows the handlers and behaviors as the `_events` and `_behaviors` properties they used to be
+ */
+HashTable *yii_base_componentstorage_get_debug_info(zval *object, int *is_temp TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch(object TSRMLS_CC);
+	HashTable *properties = Z_OBJ_HT_P(object)->get_properties(object TSRMLS_CC), *info;
+	zval *tmp;
+
+	if (!storage || (!storage->events && !storage->behaviors)) {
+		*is_temp = 0;
+		return properties;
+	}
+
+	ALLOC_HASHTABLE(info);
+	zend_hash_init(info, zend_hash_num_elements(properties) + 2, NULL, ZVAL_PTR_DTOR, 0);
+	zend_hash_copy(info, properties, (copy_ctor_func_t) zval_add_ref, (void *) &tmp, sizeof(zval *));
+
+	if (storage->events) {
+		tmp = yii_base_componentstorage_events_array(storage TSRMLS_CC);
+		zend_hash_update(info, "_events", sizeof("_events"), &tmp, sizeof(zval *), NULL);
+	}
+	if (storage->behaviors) {
+		Z_ADDREF_P(storage->behaviors);
+		zend_hash_update(info, "_behaviors", sizeof("_behaviors"), &storage->behaviors, sizeof(zval *), NULL);
+	}
+
+	*is_temp = 1;
+	return info;
+}
+
+#if PHP_VERSION_ID >= 50400
+/**
+ * Behaviors and handlers keep a reference to their owner, the collector has to see the storage to break the cycle
+ */
+HashTable *yii_base_componentstorage_get_gc(zval *object, zval ***table, int *n TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch(object TSRMLS_CC);
+	yii_base_componentstorage_list **list;
+	zend_object *zobj = &storage->std;
+	HashPosition pos;
+	int count = 1, i;
+	zend_uint j;
+
+	if (storage->events) {
+		for (zend_hash_internal_pointer_reset_ex(storage->events, &pos);
+			zend_hash_get_current_data_ex(storage->events, (void **) &list, &pos) == SUCCESS;
+			zend_hash_move_forward_ex(storage->events, &pos)) {
+			count += 2 * (*list)->count;
+		}
+	}
+
+	if (!zobj->properties) {
+		count += zobj->ce->default_properties_count;
+	}
+
+	if (storage->gc_size < count) {
+		storage->gc_table = erealloc(storage->gc_table, count * sizeof(zval *));
+		storage->gc_size = count;
+	}
+
+	i = 0;
+	storage->gc_table[i++] = storage->behaviors;
+	if (storage->events) {
+		for (zend_hash_internal_pointer_reset_ex(storage->events, &pos);
+			zend_hash_get_current_data_ex(storage->events, (void **) &list, &pos) == SUCCESS;
+			zend_hash_move_forward_ex(storage->events, &pos)) {
+			for (j = (*list)->start; j < (*list)->start + (*list)->count; j++) {
+				storage->gc_table[i++] = (*list)->entries[j].callable;
+				storage->gc_table[i++] = (*list)->entries[j].data;
+			}
+		}
+	}
+	for (j = 0; i < count; i++, j++) {
+		storage->gc_table[i] = zobj->properties_table[j];
+	}
+
+	*table = storage->gc_table;
+	*n = count;
+
+	return zobj->properties;
+}
+#endif
+
+/**
+ * Marks the behaviors as ensured.
+ * Returns whether this is the first time, in which case the declared behaviors are to be attached
+ */
+int yii_base_componentstorage_ensure(zval *object TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch(object TSRMLS_CC);
+
+	if (!storage || storage->ensured) {
+		return 0;
+	}
+
+	storage->ensured = 1;
+	return 1;
+}
+
+/**
+ * Fetches the behaviors, null until they are ensured and an empty array if there is none.
+ * Returns whether there is any behavior to look into
+ */
+int yii_base_componentstorage_behaviors(zval **result, zval *object TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch(object TSRMLS_CC);
+
+	if (storage && storage->behaviors) {
+		*result = storage->behaviors;
+		Z_ADDREF_P(*result);
+		return zend_hash_num_elements(Z_ARRVAL_P(storage->behaviors)) > 0;
+	}
+
+	MAKE_STD_ZVAL(*result);
+	if (storage && storage->ensured) {
+		array_init(*result);
+	} else {
+		ZVAL_NULL(*result);
+	}
+	return 0;
+}
+
+/**
+ * Fetches a behavior by name, leaving result untouched if there is none
+ */
+int yii_base_componentstorage_behavior(zval **result, zval *object, zval *name TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch(object TSRMLS_CC);
+	zval *behavior;
+
+	if (!storage || !storage->behaviors || !zephir_array_isset_fetch(&behavior, storage->behaviors, name, 1 TSRMLS_CC)) {
+		return 0;
+	}
+
+	*result = behavior;
+	Z_ADDREF_P(*result);
+	return 1;
+}
+
+void yii_base_componentstorage_attach(zval *object, zval *name, zval *behavior TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch_write(object TSRMLS_CC);
+
+	if (storage) {
+		if (!storage->behaviors) {
+			MAKE_STD_ZVAL(storage->behaviors);
+			array_init(storage->behaviors);
+		}
+		yii_base_componentstorage_forget(storage);
+		zephir_array_slot_apply(&storage->behaviors, ZEPHIR_ARRAY_PATH_UPDATE, behavior, 1, name);
+	}
+}
+
+void yii_base_componentstorage_detach(zval *object, zval *name TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch(object TSRMLS_CC);
+
+	if (storage && storage->behaviors) {
+		yii_base_componentstorage_forget(storage);
+		zephir_array_slot_apply(&storage->behaviors, ZEPHIR_ARRAY_PATH_UNSET, NULL, 1, name);
+	}
+}
+
+/**
+ * Finds the first behavior providing a member, asking the behaviors in order the first time.
+ * Returns whether one was found, target->behavior is then referenced for the caller
+ */
+static int yii_base_componentstorage_target_find(yii_base_componentstorage_target *target, yii_base_componentstorage *storage, zval *name, int kind TSRMLS_DC)
+{
+	yii_base_componentstorage_target *found;
+	zval *behaviors, **behavior, *retval, *params[1];
+	zend_function *method;
+	zend_uint generation, key_length;
+	char buffer[64], *key, *lcname;
+	HashPosition pos;
+	int provided, remember = 1, status = 0;
+
+	target->behavior = NULL;
+	target->method = NULL;
+
+	if (!storage->behaviors || Z_TYPE_P(name) != IS_STRING || zend_hash_num_elements(Z_ARRVAL_P(storage->behaviors)) == 0) {
+		return 0;
+	}
+
+	/* The kind prefixes the member name */
+	key_length = Z_STRLEN_P(name) + 2;
+	key = key_length <= sizeof(buffer) ? buffer : emalloc(key_length);
+	key[0] = '0' + kind;
+	memcpy(key + 1, Z_STRVAL_P(name), Z_STRLEN_P(name) + 1);
+
+	if (storage->targets && zend_hash_find(storage->targets, key, key_length, (void **) &found) == SUCCESS) {
+		if (found->behavior) {
+			*target = *found;
+			Z_ADDREF_P(target->behavior);
+			status = 1;
+		}
+		if (key != buffer) {
+			efree(key);
+		}
+		return status;
+	}
+
+	/* A behavior asked may change the behaviors, the answer is only remembered if it did not */
+	behaviors = storage->behaviors;
+	Z_ADDREF_P(behaviors);
+	generation = storage->generation;
+	params[0] = name;
+
+	for (
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(behaviors), &pos);
+		zend_hash_get_current_data_ex(Z_ARRVAL_P(behaviors), (void **) &behavior, &pos) == SUCCESS;
+		zend_hash_move_forward_ex(Z_ARRVAL_P(behaviors), &pos)
+	) {
+		if (Z_TYPE_PP(behavior) != IS_OBJECT) {
+			continue;
+		}
+
+		retval = NULL;
+		if (zephir_call_class_method_aparams(&retval, Z_OBJCE_PP(behavior), zephir_fcall_method, *behavior, (char *) yii_base_componentstorage_checks[kind], strlen(yii_base_componentstorage_checks[kind]), NULL, 1, params TSRMLS_CC) == FAILURE || EG(exception)) {
+			if (retval) {
+				zval_ptr_dtor(&retval);
+			}
+			remember = 0;
+			break;
+		}
+
+		provided = zend_is_true(retval);
+		zval_ptr_dtor(&retval);
+
+		if (provided) {
+			target->behavior = *behavior;
+			Z_ADDREF_P(target->behavior);
+			status = 1;
+			break;
+		}
+	}
+
+	zval_ptr_dtor(&behaviors);
+
+	/* Only public methods are called directly, the others go through __call() or fail as callables do */
+	if (status && kind == YII_COMPONENT_METHOD) {
+		lcname = zend_str_tolower_dup(Z_STRVAL_P(name), Z_STRLEN_P(name));
+		if (zend_hash_find(&Z_OBJCE_P(target->behavior)->function_table, lcname, Z_STRLEN_P(name) + 1, (void **) &method) == SUCCESS
+			&& (method->common.fn_flags & ZEND_ACC_PUBLIC) && !(method->common.fn_flags & ZEND_ACC_ABSTRACT)) {
+			target->method = method;
+		}
+		efree(lcname);
+	}
+
+	if (remember && generation == storage->generation) {
+		if (!storage->targets) {
+			ALLOC_HASHTABLE(storage->targets);
+			zend_hash_init(storage->targets, 8, NULL, NULL, 0);
+		}
+		zend_hash_update(storage->targets, key, key_length, target, sizeof(yii_base_componentstorage_target), NULL);
+	}
+
+	if (key != buffer) {
+		efree(key);
+	}
+
+	return status;
+}
+
+/**
+ * Fetches the first behavior providing a method or a readable or writable property, by YII_COMPONENT_* kind.
+ * Returns whether there is one, leaving result untouched otherwise
+ */
+int yii_base_componentstorage_provider(zval **result, zval *object, zval *name, int kind TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch(object TSRMLS_CC);
+	yii_base_componentstorage_target target;
+
+	if (!storage || !yii_base_componentstorage_target_find(&target, storage, name, kind TSRMLS_CC)) {
+		return 0;
+	}
+
+	*result = target.behavior;
+	return 1;
+}
+
+/**
+ * Calls a method provided by a behavior, with the target found by the first call.
+ * Returns whether a behavior provides the method, leaving result untouched otherwise
+ */
+int yii_base_componentstorage_call(zval **result, zval *object, zval *name, zval *params TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch(object TSRMLS_CC);
+	yii_base_componentstorage_target target;
+	zend_fcall_info fci;
+	zend_fcall_info_cache fcc;
+	zval *retval = NULL, *callable;
+
+	if (!storage || !yii_base_componentstorage_target_find(&target, storage, name, YII_COMPONENT_METHOD TSRMLS_CC)) {
+		return 0;
+	}
+
+	if (target.method) {
+		fci.size = sizeof(fci);
+		fci.function_table = &Z_OBJCE_P(target.behavior)->function_table;
+		fci.function_name = name;
+		fci.symbol_table = NULL;
+		fci.object_ptr = target.behavior;
+		fci.retval_ptr_ptr = &retval;
+		fci.param_count = 0;
+		fci.params = NULL;
+		fci.no_separation = 0;
+
+		fcc.initialized = 1;
+		fcc.function_handler = target.method;
+		fcc.calling_scope = Z_OBJCE_P(target.behavior);
+		fcc.called_scope = Z_OBJCE_P(target.behavior);
+		fcc.object_ptr = target.behavior;
+
+		if (Z_TYPE_P(params) == IS_ARRAY) {
+			zend_fcall_info_args(&fci, params TSRMLS_CC);
+		}
+
+		zend_call_function(&fci, &fcc TSRMLS_CC);
+		zend_fcall_info_args_clear(&fci, 1);
+	} else {
+		MAKE_STD_ZVAL(callable);
+		array_init_size(callable, 2);
+		Z_ADDREF_P(target.behavior);
+		add_next_index_zval(callable, target.behavior);
+		Z_ADDREF_P(name);
+		add_next_index_zval(callable, name);
+
+		MAKE_STD_ZVAL(retval);
+		ZVAL_NULL(retval);
+		if (zephir_call_user_func_array_noex(retval, callable, params TSRMLS_CC) == FAILURE) {
+			/* the call has already warned about the callable */
+			ZVAL_NULL(retval);
+		}
+		zval_ptr_dtor(&callable);
+	}
+
+	zval_ptr_dtor(&target.behavior);
+
+	if (!retval) {
+		MAKE_STD_ZVAL(retval);
+		ZVAL_NULL(retval);
+	}
+
+	*result = retval;
+	return 1;
+}
+
+/**
+ * Releases a reference to a handler list, destroying the list with the last one
+ */
+static void yii_base_componentstorage_list_release(yii_base_componentstorage_list *list)
+{
+	zend_uint i;
+
+	if (--list->refcount > 0) {
+		return;
+	}
+
+	for (i = list->start; i < list->start + list->count; i++) {
+		zval_ptr_dtor(&list->entries[i].callable);
+		zval_ptr_dtor(&list->entries[i].data);
+	}
+
+	if (list->entries) {
+		efree(list->entries);
+	}
+	efree(list);
+}
+
+static void yii_base_componentstorage_list_dtor(void *list)
+{
+	yii_base_componentstorage_list_release(*(yii_base_componentstorage_list **) list);
+}
+
+/**
+ * Returns the handler list of an event ready to be changed, copying it if a trigger is iterating over it
+ */
+static yii_base_componentstorage_list *yii_base_componentstorage_list_separate(yii_base_componentstorage_list **slot)
+{
+	yii_base_componentstorage_list *list = *slot, *copy;
+	zend_uint i;
+
+	if (list->refcount == 1) {
+		return list;
+	}
+
+	copy = ecalloc(1, sizeof(yii_base_componentstorage_list));
+	copy->refcount = 1;
+	copy->size = list->count;
+	copy->count = list->count;
+
+	if (list->count) {
+		copy->entries = safe_emalloc(list->count, sizeof(yii_base_componentstorage_handler), 0);
+		memcpy(copy->entries, list->entries + list->start, list->count * sizeof(yii_base_componentstorage_handler));
+		for (i = 0; i < copy->count; i++) {
+			Z_ADDREF_P(copy->entries[i].callable);
+			Z_ADDREF_P(copy->entries[i].data);
+		}
+	}
+
+	yii_base_componentstorage_list_release(list);
+	*slot = copy;
+
+	return copy;
+}
+
+/**
+ * Makes room for one handler at either end of a list, keeping free slots at the front
+ * so that prepending takes constant amortized time as appending does
+ */
+static yii_base_componentstorage_handler *yii_base_componentstorage_list_insert(yii_base_componentstorage_list *list, int append)
+{
+	yii_base_componentstorage_handler *entries;
+	zend_uint size, start;
+
+	if (append ? list->start + list->count == list->size : list->start == 0) {
+		size = list->size ? list->size * 2 : 4;
+		start = append ? list->start : size - list->size + list->start;
+		entries = safe_emalloc(size, sizeof(yii_base_componentstorage_handler), 0);
+		if (list->count) {
+			memcpy(entries + start, list->entries + list->start, list->count * sizeof(yii_base_componentstorage_handler));
+		}
+		if (list->entries) {
+			efree(list->entries);
+		}
+		list->entries = entries;
+		list->size = size;
+		list->start = start;
+	}
+
+	list->count++;
+	if (append) {
+		return &list->entries[list->start + list->count - 1];
+	}
+
+	return &list->entries[--list->start];
+}
+
+/**
+ * Returns the handler list of an event, NULL if no handler is attached to it
+ */
+static yii_base_componentstorage_list *yii_base_componentstorage_list_find(yii_base_componentstorage *storage, zval *name, yii_base_componentstorage_list ***slot)
+{
+	yii_base_componentstorage_list **found;
+
+	if (!storage || !storage->events || Z_TYPE_P(name) != IS_STRING
+		|| zend_symtable_find(storage->events, Z_STRVAL_P(name), Z_STRLEN_P(name) + 1, (void **) &found) == FAILURE
+		|| (*found)->count == 0) {
+		return NULL;
+	}
+
+	if (slot) {
+		*slot = found;
+	}
+
+	return *found;
+}
+
+/**
+ * Adds delta to the number of handlers attached to an event name, counting the handlers of the components
+ * and the class-level ones. The numbers are kept in Event::$_listeners, a name counting none is removed
+ */
+void yii_base_componentstorage_listen(zval *name, zval *delta TSRMLS_DC)
+{
+	zval *listeners, **current, *count;
+	long value;
+
+	value = Z_TYPE_P(delta) == IS_LONG ? Z_LVAL_P(delta) : zephir_get_intval(delta);
+	if (!value || Z_TYPE_P(name) != IS_STRING) {
+		return;
+	}
+
+	listeners = zephir_fetch_static_property_ce(yii_base_event_ce, SL("_listeners") TSRMLS_CC);
+	if (listeners && Z_TYPE_P(listeners) == IS_ARRAY
+		&& zend_symtable_find(Z_ARRVAL_P(listeners), Z_STRVAL_P(name), Z_STRLEN_P(name) + 1, (void **) &current) == SUCCESS) {
+		value += zephir_get_intval(*current);
+	}
+
+	if (value <= 0) {
+		zephir_static_property_array_unset(yii_base_event_ce, SL("_listeners") TSRMLS_CC, 1, name);
+		return;
+	}
+
+	MAKE_STD_ZVAL(count);
+	ZVAL_LONG(count, value);
+	zephir_static_property_array_update(yii_base_event_ce, SL("_listeners"), count TSRMLS_CC, 1, name);
+	zval_ptr_dtor(&count);
+}
+
+/**
+ * Tells whether a trigger of an event may find a handler, be it attached to a component or to a class.
+ * Until the behaviors of the component are ensured, they may attach handlers of their own and the answer is yes
+ */
+int yii_base_componentstorage_listened(zval *object, zval *name TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch(object TSRMLS_CC);
+	zval *listeners;
+
+	if (!storage || !storage->ensured || Z_TYPE_P(name) != IS_STRING) {
+		return 1;
+	}
+
+	listeners = zephir_fetch_static_property_ce(yii_base_event_ce, SL("_listeners") TSRMLS_CC);
+
+	return listeners && Z_TYPE_P(listeners) == IS_ARRAY
+		&& zend_symtable_exists(Z_ARRVAL_P(listeners), Z_STRVAL_P(name), Z_STRLEN_P(name) + 1);
+}
+
+/**
+ * Takes the handlers of a component out of the counts of Event::$_listeners
+ */
+static void yii_base_componentstorage_unlisten(yii_base_componentstorage *storage TSRMLS_DC)
+{
+	yii_base_componentstorage_list **list;
+	HashPosition pos;
+	zval name, delta;
+	char *key;
+	uint key_len;
+	ulong index;
+	int numeric;
+
+	for (zend_hash_internal_pointer_reset_ex(storage->events, &pos);
+		zend_hash_get_current_data_ex(storage->events, (void **) &list, &pos) == SUCCESS;
+		zend_hash_move_forward_ex(storage->events, &pos)) {
+
+		if ((*list)->count == 0) {
+			continue;
+		}
+
+		INIT_ZVAL(name);
+		numeric = zend_hash_get_current_key_ex(storage->events, &key, &key_len, &index, 0, &pos) != HASH_KEY_IS_STRING;
+		if (numeric) {
+			ZVAL_LONG(&name, index);
+			convert_to_string(&name);
+		} else {
+			ZVAL_STRINGL(&name, key, key_len - 1, 0);
+		}
+
+		INIT_ZVAL(delta);
+		ZVAL_LONG(&delta, -(long) (*list)->count);
+		yii_base_componentstorage_listen(&name, &delta TSRMLS_CC);
+
+		if (numeric) {
+			zval_dtor(&name);
+		}
+	}
+}
+
+/**
+ * Returns whether any handler is attached to an event
+ */
+int yii_base_componentstorage_has_handlers(zval *object, zval *name TSRMLS_DC)
+{
+	return yii_base_componentstorage_list_find(yii_base_componentstorage_fetch(object TSRMLS_CC), name, NULL) != NULL;
+}
+
+/**
+ * Attaches a handler to an event. The callable is resolved now, unless it cannot be yet or it goes
+ * through __call(), in which case it is resolved on each call as call_user_func() did
+ */
+void yii_base_componentstorage_on(zval *object, zval *name, zval *handler, zval *data, zval *append TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch_write(object TSRMLS_CC);
+	yii_base_componentstorage_list *list, **slot;
+	yii_base_componentstorage_handler *entry;
+	zend_fcall_info_cache fcc;
+	zval delta;
+	char *error = NULL;
+
+	if (!storage || Z_TYPE_P(name) != IS_STRING) {
+		return;
+	}
+
+	if (!storage->events) {
+		ALLOC_HASHTABLE(storage->events);
+		zend_hash_init(storage->events, 8, NULL, yii_base_componentstorage_list_dtor, 0);
+	}
+
+	if (zend_symtable_find(storage->events, Z_STRVAL_P(name), Z_STRLEN_P(name) + 1, (void **) &slot) == SUCCESS) {
+		list = yii_base_componentstorage_list_separate(slot);
+	} else {
+		list = ecalloc(1, sizeof(yii_base_componentstorage_list));
+		list->refcount = 1;
+		zend_symtable_update(storage->events, Z_STRVAL_P(name), Z_STRLEN_P(name) + 1, (void *) &list, sizeof(yii_base_componentstorage_list *), NULL);
+	}
+
+	memset(&fcc, 0, sizeof(fcc));
+	if (zend_is_callable_ex(handler, NULL, 0, NULL, NULL, &fcc, &error TSRMLS_CC)) {
+		if (fcc.function_handler && ((fcc.function_handler->type == ZEND_INTERNAL_FUNCTION && (fcc.function_handler->common.fn_flags & ZEND_ACC_CALL_VIA_HANDLER))
+			|| fcc.function_handler->type == ZEND_OVERLOADED_FUNCTION_TEMPORARY || fcc.function_handler->type == ZEND_OVERLOADED_FUNCTION)) {
+			/* The trampoline of __call() lives for a single call, as zend_is_callable() frees it */
+			if (fcc.function_handler->type != ZEND_OVERLOADED_FUNCTION) {
+				efree((char *) fcc.function_handler->common.function_name);
+			}
+			efree(fcc.function_handler);
+			fcc.initialized = 0;
+		}
+	} else {
+		fcc.initialized = 0;
+	}
+	if (error) {
+		efree(error);
+	}
+
+	entry = yii_base_componentstorage_list_insert(list, zend_is_true(append));
+	entry->callable = handler;
+	Z_ADDREF_P(handler);
+	entry->data = data;
+	Z_ADDREF_P(data);
+	entry->fcc = fcc;
+
+	INIT_ZVAL(delta);
+	ZVAL_LONG(&delta, 1);
+	yii_base_componentstorage_listen(name, &delta TSRMLS_CC);
+}
+
+/**
+ * Detaches a handler, compared with ==, or all of them when handler is null.
+ * Returns whether anything was detached
+ */
+int yii_base_componentstorage_off(zval *object, zval *name, zval *handler TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch(object TSRMLS_CC);
+	yii_base_componentstorage_list *list, **slot;
+	yii_base_componentstorage_handler *entry;
+	zend_uint i, kept = 0;
+	zval result, delta;
+	int removed = 0;
+
+	if (!yii_base_componentstorage_list_find(storage, name, &slot)) {
+		return 0;
+	}
+
+	if (!handler || Z_TYPE_P(handler) == IS_NULL) {
+		INIT_ZVAL(delta);
+		ZVAL_LONG(&delta, -(long) (*slot)->count);
+		zend_symtable_del(storage->events, Z_STRVAL_P(name), Z_STRLEN_P(name) + 1);
+		yii_base_componentstorage_listen(name, &delta TSRMLS_CC);
+		return 1;
+	}
+
+	for (i = 0; i < (*slot)->count; i++) {
+		is_equal_function(&result, (*slot)->entries[(*slot)->start + i].callable, handler TSRMLS_CC);
+		if (Z_LVAL(result)) {
+			removed = 1;
+			break;
+		}
+	}
+
+	if (!removed) {
+		return 0;
+	}
+
+	/* The remaining handlers keep their order */
+	list = yii_base_componentstorage_list_separate(slot);
+	for (i = 0; i < list->count; i++) {
+		entry = &list->entries[list->start + i];
+		is_equal_function(&result, entry->callable, handler TSRMLS_CC);
+		if (Z_LVAL(result)) {
+			zval_ptr_dtor(&entry->callable);
+			zval_ptr_dtor(&entry->data);
+		} else {
+			list->entries[list->start + kept++] = *entry;
+		}
+	}
+	INIT_ZVAL(delta);
+	ZVAL_LONG(&delta, -(long) (list->count - kept));
+	list->count = kept;
+	yii_base_componentstorage_listen(name, &delta TSRMLS_CC);
+
+	return 1;
+}
+
+/**
+ * Calls the handlers attached to an event in order, setting the data of the event for each one.
+ * Returns whether the handling stopped, because a handler marked the event as handled or threw
+ */
+int yii_base_componentstorage_trigger(zval *object, zval *name, zval *event TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch(object TSRMLS_CC);
+	yii_base_componentstorage_list *list;
+	yii_base_componentstorage_handler *entry;
+	zend_fcall_info fci;
+	zval *retval, **params[1], *handled;
+	zend_uint i;
+	int stopped = 0;
+
+	list = yii_base_componentstorage_list_find(storage, name, NULL);
+	if (!list || Z_TYPE_P(event) != IS_OBJECT) {
+		return 0;
+	}
+
+	/* Handlers attached or detached meanwhile change a copy of the list */
+	list->refcount++;
+	params[0] = &event;
+
+	for (i = 0; i < list->count; i++) {
+
+		entry = &list->entries[list->start + i];
+		zend_update_property(Z_OBJCE_P(event), event, SL("data"), entry->data TSRMLS_CC);
+
+		retval = NULL;
+		fci.size = sizeof(fci);
+		fci.function_table = EG(function_table);
+		fci.function_name = entry->callable;
+		fci.symbol_table = NULL;
+		fci.object_ptr = entry->fcc.initialized ? entry->fcc.object_ptr : NULL;
+		fci.retval_ptr_ptr = &retval;
+		fci.param_count = 1;
+		fci.params = params;
+		fci.no_separation = 1;
+
+		zend_call_function(&fci, entry->fcc.initialized ? &entry->fcc : NULL TSRMLS_CC);
+		if (retval) {
+			zval_ptr_dtor(&retval);
+		}
+
+		if (EG(exception)) {
+			stopped = 1;
+			break;
+		}
+
+		/* stop further handling if the event is handled */
+		handled = zend_read_property(Z_OBJCE_P(event), event, SL("handled"), 1 TSRMLS_CC);
+		if (zend_is_true(handled)) {
+			stopped = 1;
+			break;
+		}
+	}
+
+	yii_base_componentstorage_list_release(list);
+	return stopped;
+}
+
+/**
+ * Drops the handlers and behaviors, the behaviors are ensured again on next use
+ */
+void yii_base_componentstorage_reset(zval *object TSRMLS_DC)
+{
+	yii_base_componentstorage *storage = yii_base_componentstorage_fetch(object TSRMLS_CC);
+
+	if (!storage) {
+		return;
+	}
+
+	yii_base_componentstorage_forget(storage);
+
+	if (storage->events) {
+		yii_base_componentstorage_unlisten(storage TSRMLS_CC);
+		zend_hash_destroy(storage->events);
+		FREE_HASHTABLE(storage->events);
+		storage->events = NULL;
+	}
+	if (storage->behaviors) {
+		zval_ptr_dtor(&storage->behaviors);
+		storage->behaviors = NULL;
+	}
+	storage->ensured = 0;
+}
+
+/**
+ * Installs the storage on the implementing class and on every class inheriting it
+ */
+static int yii_base_componentstorage_implemented(zend_class_entry *iface, zend_class_entry *ce TSRMLS_DC)
+{
+	if (!ce->create_object) {
+		ce->create_object = yii_base_componentstorage_create_object;
+	}
+
+	return SUCCESS;
+}
+
+ZEPHIR_INIT_CLASS(yii_base_ComponentStorageInterface) {
+
+	ZEPHIR_REGISTER_INTERFACE(yii\\base, ComponentStorageInterface, yii, base_componentstorageinterface, NULL);
+
+	yii_base_componentstorageinterface_ce->interface_gets_implemented = yii_base_componentstorage_implemented;
+
+	memcpy(&yii_base_componentstorage_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+	yii_base_componentstorage_handlers.clone_obj = yii_base_componentstorage_clone_obj;
+	yii_base_componentstorage_handlers.get_debug_info = yii_base_componentstorage_get_debug_info;
+#if PHP_VERSION_ID >= 50400
+	yii_base_componentstorage_handlers.get_gc = yii_base_componentstorage_get_gc;
+#endif
+
+	return SUCCESS;
+
+}
+
@@ -0,0 +1,41 @@
+
+extern zend_class_entry *yii_base_componentstorageinterface_ce;
+
+ZEPHIR_INIT_CLASS(yii_base_ComponentStorageInterface);
+
+/** Object storage shared by the component classes */
+zend_object_value yii_base_componentstorage_create_object(zend_class_entry *ce TSRMLS_DC);
+zend_object_value yii_base_componentstorage_create(zend_class_entry *ce, zend_object_handlers *handlers TSRMLS_DC);
+zend_object_value yii_base_componentstorage_clone_obj(zval *object TSRMLS_DC);
+HashTable *yii_base_componentstorage_get_debug_info(zval *object, int *is_temp TSRMLS_DC);
+#if PHP_VERSION_ID >= 50400
+HashTable *yii_base_componentstorage_get_gc(zval *object, zval ***table, int *n TSRMLS_DC);
+#endif
+
+/** Behaviors */
+int yii_base_componentstorage_ensure(zval *object TSRMLS_DC);
+int yii_base_componentstorage_behaviors(zval **result, zval *object TSRMLS_DC);
+int yii_base_componentstorage_behavior(zval **result, zval *object, zval *name TSRMLS_DC);
+void yii_base_componentstorage_attach(zval *object, zval *name, zval *behavior TSRMLS_DC);
+void yii_base_componentstorage_detach(zval *object, zval *name TSRMLS_DC);
+
+/** Members provided by behaviors */
+#define YII_COMPONENT_METHOD   0
+#define YII_COMPONENT_READABLE 1
+#define YII_COMPONENT_WRITABLE 2
+
+int yii_base_componentstorage_provider(zval **result, zval *object, zval *name, int kind TSRMLS_DC);
+int yii_base_componentstorage_call(zval **result, zval *object, zval *name, zval *params TSRMLS_DC);
+
+/** Event handlers */
+int yii_base_componentstorage_has_handlers(zval *object, zval *name TSRMLS_DC);
+void yii_base_componentstorage_on(zval *object, zval *name, zval *handler, zval *data, zval *append TSRMLS_DC);
+int yii_base_componentstorage_off(zval *object, zval *name, zval *handler TSRMLS_DC);
+int yii_base_componentstorage_trigger(zval *object, zval *name, zval *event TSRMLS_DC);
+
+/** Event names handled anywhere */
+void yii_base_componentstorage_listen(zval *name, zval *delta TSRMLS_DC);
+int yii_base_componentstorage_listened(zval *object, zval *name TSRMLS_DC);
+
+void yii_base_componentstorage_reset(zval *object TSRMLS_DC);
+
@@ -0,0 +1,196 @@
+
+#ifdef HAVE_CONFIG_H
+#include "../../ext_config.h"
+#endif
+
+#include <php.h>
+#include "../../php_ext.h"
+#include "../../ext.h"
+
+#include <Zend/zend_objects.h>
+#include <Zend/zend_object_handlers.h>
+
+#include "kernel/main.h"
+#include "kernel/fcall.h"
+#include "kernel/object.h"
+#include "kernel/array.h"
+
+
+/**
+ * @link http://www.yiiframework.com/
+ * @copyright Copyright (c) 2008 Yii Software LLC
+ * @license http://www.yiiframework.com/license/
+ */
+/**
+ * ComponentAccessInterface gives a [[ServiceLocator]] native object handlers for reading its components as properties.
+ *
+ * Every class implementing the interface, including the classes inheriting it, is created with handlers
+ * that look `$locator->id` up in the `_components` and `_definitions` tables before anything else, so the
+ * common `Yii::$app->db` access no longer goes through `__get()`, `has()` and `get()` as userland calls.
+ * Declared and dynamic properties still take precedence, and a miss falls through to the standard
+ * handlers, that is to `__get()`, `__isset()` and the getters.
+ *
+ * The fast path is skipped for classes overriding `__get()` or `__isset()` and while a profiler is attached,
+ * so that those see every access.
+ *
+ * @since 2.0
+ */
+
+#if PHP_VERSION_ID >= 50400
+#define YII_COMPONENTACCESS_KEY_DC , const zend_literal *key
+#define YII_COMPONENTACCESS_KEY_CC , key
+#define YII_COMPONENTACCESS_HASH(member) (key ? key->hash_value : zend_hash_func(Z_STRVAL_P(member), Z_STRLEN_P(member) + 1))
+#else
+#define YII_COMPONENTACCESS_KEY_DC
+#define YII_COMPONENTACCESS_KEY_CC
+#define YII_COMPONENTACCESS_HASH(member) zend_hash_func(Z_STRVAL_P(member), Z_STRLEN_P(member) + 1)
+#endif
+
+zend_class_entry *yii_di_componentaccessinterface_ce;
+
+static zend_object_handlers yii_di_componentaccess_handlers;
+
+/**
+ * Tells whether a member may name a component rather than a property of the locator
+ */
+static int yii_di_componentaccess_applies(zval *object, zval *member, ulong hash, zend_function *magic TSRMLS_DC)
+{
+	zend_object *zobj;
+
+	/* A subclass overriding the magic method decides on the components itself */
+	if (!magic || magic->common.scope != yii_di_servicelocator_ce) {
+		return 0;
+	}
+
+	/* Declared and dynamic properties are found before __get() is ever called */
+	if (zend_hash_quick_exists(&Z_OBJCE_P(object)->properties_info, Z_STRVAL_P(member), Z_STRLEN_P(member) + 1, hash)) {
+		return 0;
+	}
+
+	zobj = zend_objects_get_address(object TSRMLS_CC);
+	if (zobj->properties && zend_hash_quick_exists(zobj->properties, Z_STRVAL_P(member), Z_STRLEN_P(member) + 1, hash)) {
+		return 0;
+	}
+
+	/* A profiled locator records every access through get() */
+	return Z_TYPE_P(zephir_fetch_nproperty_this(object, SL("_profiler"), PH_SILENT_CC)) != IS_OBJECT;
+}
+
+/**
+ * Returns the __get() guard of a member, the one the standard handlers use to stop recursion
+ */
+static zend_guard *yii_di_componentaccess_guard(zend_object *zobj, zval *member, ulong hash)
+{
+	zend_guard stub, *guard;
+
+	if (!zobj->guards) {
+		ALLOC_HASHTABLE(zobj->guards);
+		zend_hash_init(zobj->guards, 0, NULL, NULL, 0);
+	} else if (zend_hash_quick_find(zobj->guards, Z_STRVAL_P(member), Z_STRLEN_P(member) + 1, hash, (void **) &guard) == SUCCESS) {
+		return guard;
+	}
+
+	memset(&stub, 0, sizeof(zend_guard));
+	zend_hash_quick_add(zobj->guards, Z_STRVAL_P(member), Z_STRLEN_P(member) + 1, hash, &stub, sizeof(zend_guard), (void **) &guard);
+	return guard;
+}
+
+static zval *yii_di_componentaccess_read_property(zval *object, zval *member, int type YII_COMPONENTACCESS_KEY_DC TSRMLS_DC)
+{
+	zval *components, *definitions, *component, *retval = NULL;
+	zend_guard *guard;
+	ulong hash;
+	int status;
+
+	if (Z_TYPE_P(member) != IS_STRING) {
+		return zend_std_read_property(object, member, type YII_COMPONENTACCESS_KEY_CC TSRMLS_CC);
+	}
+
+	hash = YII_COMPONENTACCESS_HASH(member);
+	if (!yii_di_componentaccess_applies(object, member, hash, Z_OBJCE_P(object)->__get TSRMLS_CC)) {
+		return zend_std_read_property(object, member, type YII_COMPONENTACCESS_KEY_CC TSRMLS_CC);
+	}
+
+	components = zephir_fetch_nproperty_this(object, SL("_components"), PH_SILENT_CC);
+	if (Z_TYPE_P(components) == IS_ARRAY && zephir_array_isset_fetch(&component, components, member, 1 TSRMLS_CC) && Z_TYPE_P(component) != IS_NULL) {
+		return component;
+	}
+
+	definitions = zephir_fetch_nproperty_this(object, SL("_definitions"), PH_SILENT_CC);
+	if (Z_TYPE_P(definitions) != IS_ARRAY || !zephir_array_isset(definitions, member)) {
+		return zend_std_read_property(object, member, type YII_COMPONENTACCESS_KEY_CC TSRMLS_CC);
+	}
+
+	/* A component read while it is being created gets the same treatment as a recursive __get() */
+	guard = yii_di_componentaccess_guard(zend_objects_get_address(object TSRMLS_CC), member, hash);
+	if (guard->in_get) {
+		return zend_std_read_property(object, member, type YII_COMPONENTACCESS_KEY_CC TSRMLS_CC);
+	}
+
+	/* As zend_std_call_getter() does, the locator is held while its factory runs */
+	Z_ADDREF_P(object);
+	guard->in_get = 1;
+	status = zephir_call_class_method_aparams(&retval, Z_OBJCE_P(object), zephir_fcall_method, object, SL("get"), NULL, 1, &member TSRMLS_CC);
+	guard->in_get = 0;
+	zval_ptr_dtor(&object);
+
+	if (status == FAILURE || !retval) {
+		return EG(uninitialized_zval_ptr);
+	}
+
+	/* As with the result of __get(), the engine takes its own reference */
+	Z_DELREF_P(retval);
+	return retval;
+}
+
+static int yii_di_componentaccess_has_property(zval *object, zval *member, int has_set_exists YII_COMPONENTACCESS_KEY_DC TSRMLS_DC)
+{
+	zval *components, *component;
+
+	if (Z_TYPE_P(member) == IS_STRING && yii_di_componentaccess_applies(object, member, YII_COMPONENTACCESS_HASH(member), Z_OBJCE_P(object)->__isset TSRMLS_CC)) {
+		components = zephir_fetch_nproperty_this(object, SL("_components"), PH_SILENT_CC);
+		if (Z_TYPE_P(components) == IS_ARRAY && zephir_array_isset_fetch(&component, components, member, 1 TSRMLS_CC) && Z_TYPE_P(component) != IS_NULL) {
+			return 1;
+		}
+	}
+
+	return zend_std_has_property(object, member, has_set_exists YII_COMPONENTACCESS_KEY_CC TSRMLS_CC);
+}
+
+static zend_object_value yii_di_componentaccess_create_object(zend_class_entry *ce TSRMLS_DC)
+{
+	return yii_base_componentstorage_create(ce, &yii_di_componentaccess_handlers TSRMLS_CC);
+}
+
+/**
+ * Installs the handlers on the implementing class and on every class inheriting it
+ */
+static int yii_di_componentaccess_implemented(zend_class_entry *iface, zend_class_entry *ce TSRMLS_DC)
+{
+	/* The locators are components: their storage is created along with the handlers */
+	if (!ce->create_object || ce->create_object == yii_base_componentstorage_create_object) {
+		ce->create_object = yii_di_componentaccess_create_object;
+	}
+
+	return SUCCESS;
+}
+
+ZEPHIR_INIT_CLASS(yii_di_ComponentAccessInterface) {
+
+	ZEPHIR_REGISTER_INTERFACE(yii\\di, ComponentAccessInterface, yii, di_componentaccessinterface, NULL);
+
+	yii_di_componentaccessinterface_ce->interface_gets_implemented = yii_di_componentaccess_implemented;
+
+	memcpy(&yii_di_componentaccess_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+	yii_di_componentaccess_handlers.read_property = yii_di_componentaccess_read_property;
+	yii_di_componentaccess_handlers.has_property = yii_di_componentaccess_has_property;
+	yii_di_componentaccess_handlers.clone_obj = yii_base_componentstorage_clone_obj;
+	yii_di_componentaccess_handlers.get_debug_info = yii_base_componentstorage_get_debug_info;
+#if PHP_VERSION_ID >= 50400
+	yii_di_componentaccess_handlers.get_gc = yii_base_componentstorage_get_gc;
+#endif
+
+	return SUCCESS;
+
+}
+
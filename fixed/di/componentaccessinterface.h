@@ -0,0 +1,5 @@
+
+extern zend_class_entry *yii_di_componentaccessinterface_ce;
+
+ZEPHIR_INIT_CLASS(yii_di_ComponentAccessInterface);
+
@@ -0,0 +1,544 @@
+
+#ifdef HAVE_CONFIG_H
+#include "../../ext_config.h"
+#endif
+
+#include <php.h>
+#include "../../php_ext.h"
+#include "../../ext.h"
+
+#include <Zend/zend_operators.h>
+#include <Zend/zend_exceptions.h>
+#include <Zend/zend_interfaces.h>
+
+#include "kernel/main.h"
+#include "kernel/fcall.h"
+#include "kernel/object.h"
+#include "kernel/memory.h"
+#include "kernel/array.h"
+
+
+/**
+ * @link http://www.yiiframework.com/
+ * @copyright Copyright (c) 2008 Yii Software LLC
+ * @license http://www.yiiframework.com/license/
+ */
+/**
+ * LazyProxy stands in for a component of a [[ServiceLocator]] until the component is actually used.
+ *
+ * A locator returns a proxy for the components listed in [[ServiceLocator::lazyComponents]].
+ * The component is created from its definition on the first method call or property access made
+ * through the proxy, and from then on the locator returns the component itself.
+ *
+ * Method calls, property and array accesses, casts and cloning are forwarded through object handlers,
+ * so a built proxy costs a single indirection. A proxy is not an instance of the component class, though;
+ * code relying on type checks should call [[resolve()]] or fetch the component again from the locator.
+ *
+ * @since 2.0
+ */
+
+#if PHP_VERSION_ID >= 50400
+#define YII_LAZYPROXY_KEY_DC , const zend_literal *key
+#define YII_LAZYPROXY_KEY_CC , key
+#else
+#define YII_LAZYPROXY_KEY_DC
+#define YII_LAZYPROXY_KEY_CC
+#endif
+
+typedef struct _yii_di_lazyproxy {
+	zend_object std;
+	/* locator, id, definition and component are scanned as a table by the garbage collector */
+	zval *locator;
+	zval *id;
+	zval *definition;
+	zval *component;
+	zend_bool building;
+} yii_di_lazyproxy;
+
+static zend_object_handlers yii_di_lazyproxy_handlers;
+
+static inline yii_di_lazyproxy *yii_di_lazyproxy_fetch(const zval *object TSRMLS_DC)
+{
+	return (yii_di_lazyproxy *) zend_object_store_get_object((zval *) object TSRMLS_CC);
+}
+
+/**
+ * Returns the component behind the proxy, creating it on first use.
+ * The locator is handed the component so that later lookups skip the proxy
+ */
+static zval *yii_di_lazyproxy_component(zval *object TSRMLS_DC)
+{
+	yii_di_lazyproxy *proxy = yii_di_lazyproxy_fetch(object TSRMLS_CC);
+	zval *component = NULL, *components = NULL, *current;
+	int status;
+
+	if (EXPECTED(proxy->component != NULL)) {
+		return proxy->component;
+	}
+
+	if (!proxy->definition) {
+		zend_throw_exception_ex(yii_base_invalidcallexception_ce, 0 TSRMLS_CC, "A LazyProxy must be created with LazyProxy::create().");
+		return NULL;
+	}
+
+	if (proxy->building) {
+		zend_throw_exception_ex(yii_base_invalidcallexception_ce, 0 TSRMLS_CC, "Circular reference detected while creating component \"%s\".", Z_STRVAL_P(proxy->id));
+		return NULL;
+	}
+
+	proxy->building = 1;
+	status = zephir_call_class_method_aparams(&component, yii_baseyii_ce, zephir_fcall_ce, NULL, SL("createobject"), NULL, 1, &proxy->definition TSRMLS_CC);
+	proxy->building = 0;
+
+	if (status == FAILURE || EG(exception) || !component || Z_TYPE_P(component) != IS_OBJECT) {
+		if (component) {
+			zval_ptr_dtor(&component);
+		}
+		if (!EG(exception)) {
+			zend_throw_exception_ex(yii_base_invalidconfigexception_ce, 0 TSRMLS_CC, "Unable to create component \"%s\".", Z_STRVAL_P(proxy->id));
+		}
+		return NULL;
+	}
+
+	proxy->component = component;
+
+	/* Only replace the entry if the locator still holds this proxy: the component may have been reset meanwhile */
+	zephir_read_property(&components, proxy->locator, SL("_components"), PH_NOISY_CC);
+	status = Z_TYPE_P(components) == IS_ARRAY
+		&& zephir_array_isset_fetch(&current, components, proxy->id, 1 TSRMLS_CC)
+		&& Z_TYPE_P(current) == IS_OBJECT
+		&& Z_OBJ_HANDLE_P(current) == Z_OBJ_HANDLE_P(object);
+	zval_ptr_dtor(&components);
+
+	if (status) {
+		zephir_property_array_update(proxy->locator, SL("_components"), component TSRMLS_CC, 1, proxy->id);
+	}
+
+	/* Nothing but the component is needed from now on, which also breaks the locator <-> proxy cycle */
+	zval_ptr_dtor(&proxy->definition);
+	proxy->definition = NULL;
+	zval_ptr_dtor(&proxy->locator);
+	proxy->locator = NULL;
+
+	return component;
+}
+
+static void yii_di_lazyproxy_call(INTERNAL_FUNCTION_PARAMETERS)
+{
+	zend_internal_function *func = (zend_internal_function *) EG(current_execute_data)->function_state.function;
+	zval *component, *method, *retval_ptr = NULL, ***args = NULL;
+	int argc = ZEND_NUM_ARGS();
+
+	/* The trampoline was allocated by get_method and is owned by this call */
+	MAKE_STD_ZVAL(method);
+	ZVAL_STRING(method, (char *) func->function_name, 0);
+	efree(func);
+
+	component = yii_di_lazyproxy_component(this_ptr TSRMLS_CC);
+	if (component) {
+		if (argc) {
+			args = safe_emalloc(argc, sizeof(zval **), 0);
+			zend_get_parameters_array_ex(argc, args);
+		}
+
+		call_user_function_ex(NULL, &component, method, &retval_ptr, argc, args, 0, NULL TSRMLS_CC);
+
+		if (args) {
+			efree(args);
+		}
+
+		if (retval_ptr) {
+			if (Z_ISREF_P(retval_ptr) || Z_REFCOUNT_P(retval_ptr) > 1) {
+				RETVAL_ZVAL(retval_ptr, 1, 1);
+			} else {
+				RETVAL_ZVAL(retval_ptr, 0, 1);
+			}
+		}
+	}
+
+	zval_ptr_dtor(&method);
+}
+
+#if PHP_VERSION_ID >= 50400
+static union _zend_function *yii_di_lazyproxy_get_method(zval **object_ptr, char *method, int method_len, const zend_literal *key TSRMLS_DC)
+#else
+static union _zend_function *yii_di_lazyproxy_get_method(zval **object_ptr, char *method, int method_len TSRMLS_DC)
+#endif
+{
+	zend_internal_function *func = ecalloc(1, sizeof(zend_internal_function));
+
+	func->type = ZEND_INTERNAL_FUNCTION;
+	func->handler = yii_di_lazyproxy_call;
+	func->scope = yii_di_lazyproxy_ce;
+	func->fn_flags = ZEND_ACC_CALL_VIA_HANDLER;
+	func->function_name = estrndup(method, method_len);
+
+	return (union _zend_function *) func;
+}
+
+static zval *yii_di_lazyproxy_read_property(zval *object, zval *member, int type YII_LAZYPROXY_KEY_DC TSRMLS_DC)
+{
+	zval *component = yii_di_lazyproxy_component(object TSRMLS_CC);
+
+	if (!component) {
+		return EG(uninitialized_zval_ptr);
+	}
+
+	return Z_OBJ_HT_P(component)->read_property(component, member, type YII_LAZYPROXY_KEY_CC TSRMLS_CC);
+}
+
+static void yii_di_lazyproxy_write_property(zval *object, zval *member, zval *value YII_LAZYPROXY_KEY_DC TSRMLS_DC)
+{
+	zval *component = yii_di_lazyproxy_component(object TSRMLS_CC);
+
+	if (component) {
+		Z_OBJ_HT_P(component)->write_property(component, member, value YII_LAZYPROXY_KEY_CC TSRMLS_CC);
+	}
+}
+
+static int yii_di_lazyproxy_has_property(zval *object, zval *member, int has_set_exists YII_LAZYPROXY_KEY_DC TSRMLS_DC)
+{
+	zval *component = yii_di_lazyproxy_component(object TSRMLS_CC);
+
+	if (!component) {
+		return 0;
+	}
+
+	return Z_OBJ_HT_P(component)->has_property(component, member, has_set_exists YII_LAZYPROXY_KEY_CC TSRMLS_CC);
+}
+
+static void yii_di_lazyproxy_unset_property(zval *object, zval *member YII_LAZYPROXY_KEY_DC TSRMLS_DC)
+{
+	zval *component = yii_di_lazyproxy_component(object TSRMLS_CC);
+
+	if (component) {
+		Z_OBJ_HT_P(component)->unset_property(component, member YII_LAZYPROXY_KEY_CC TSRMLS_CC);
+	}
+}
+
+#if PHP_VERSION_ID >= 50500
+static zval **yii_di_lazyproxy_get_property_ptr_ptr(zval *object, zval *member, int type, const zend_literal *key TSRMLS_DC)
+#else
+static zval **yii_di_lazyproxy_get_property_ptr_ptr(zval *object, zval *member YII_LAZYPROXY_KEY_DC TSRMLS_DC)
+#endif
+{
+	zval *component = yii_di_lazyproxy_component(object TSRMLS_CC);
+
+	if (!component || !Z_OBJ_HT_P(component)->get_property_ptr_ptr) {
+		return NULL;
+	}
+
+#if PHP_VERSION_ID >= 50500
+	return Z_OBJ_HT_P(component)->get_property_ptr_ptr(component, member, type, key TSRMLS_CC);
+#else
+	return Z_OBJ_HT_P(component)->get_property_ptr_ptr(component, member YII_LAZYPROXY_KEY_CC TSRMLS_CC);
+#endif
+}
+
+static zval *yii_di_lazyproxy_read_dimension(zval *object, zval *offset, int type TSRMLS_DC)
+{
+	zval *component = yii_di_lazyproxy_component(object TSRMLS_CC);
+
+	if (!component) {
+		return EG(uninitialized_zval_ptr);
+	}
+
+	if (!Z_OBJ_HT_P(component)->read_dimension) {
+		zend_error(E_ERROR, "Cannot use object of type %s as array", Z_OBJCE_P(component)->name);
+		return EG(uninitialized_zval_ptr);
+	}
+
+	return Z_OBJ_HT_P(component)->read_dimension(component, offset, type TSRMLS_CC);
+}
+
+static void yii_di_lazyproxy_write_dimension(zval *object, zval *offset, zval *value TSRMLS_DC)
+{
+	zval *component = yii_di_lazyproxy_component(object TSRMLS_CC);
+
+	if (!component) {
+		return;
+	}
+
+	if (!Z_OBJ_HT_P(component)->write_dimension) {
+		zend_error(E_ERROR, "Cannot use object of type %s as array", Z_OBJCE_P(component)->name);
+		return;
+	}
+
+	Z_OBJ_HT_P(component)->write_dimension(component, offset, value TSRMLS_CC);
+}
+
+static int yii_di_lazyproxy_has_dimension(zval *object, zval *offset, int check_empty TSRMLS_DC)
+{
+	zval *component = yii_di_lazyproxy_component(object TSRMLS_CC);
+
+	if (!component) {
+		return 0;
+	}
+
+	if (!Z_OBJ_HT_P(component)->has_dimension) {
+		zend_error(E_ERROR, "Cannot use object of type %s as array", Z_OBJCE_P(component)->name);
+		return 0;
+	}
+
+	return Z_OBJ_HT_P(component)->has_dimension(component, offset, check_empty TSRMLS_CC);
+}
+
+static void yii_di_lazyproxy_unset_dimension(zval *object, zval *offset TSRMLS_DC)
+{
+	zval *component = yii_di_lazyproxy_component(object TSRMLS_CC);
+
+	if (!component) {
+		return;
+	}
+
+	if (!Z_OBJ_HT_P(component)->unset_dimension) {
+		zend_error(E_ERROR, "Cannot use object of type %s as array", Z_OBJCE_P(component)->name);
+		return;
+	}
+
+	Z_OBJ_HT_P(component)->unset_dimension(component, offset TSRMLS_CC);
+}
+
+/**
+ * Inspecting a proxy (var_dump, foreach, get_object_vars) never builds the component
+ */
+static HashTable *yii_di_lazyproxy_get_properties(zval *object TSRMLS_DC)
+{
+#if PHP_VERSION_ID >= 50400
+	yii_di_lazyproxy *proxy = yii_di_lazyproxy_fetch(object TSRMLS_CC);
+
+	if (proxy->component && Z_OBJ_HT_P(proxy->component)->get_properties) {
+		return Z_OBJ_HT_P(proxy->component)->get_properties(proxy->component TSRMLS_CC);
+	}
+#endif
+
+	/* PHP 5.3 collects cycles through get_properties, which must only report the proxy's own table */
+	return zend_std_get_properties(object TSRMLS_CC);
+}
+
+#if PHP_VERSION_ID >= 50400
+static HashTable *yii_di_lazyproxy_get_gc(zval *object, zval ***table, int *n TSRMLS_DC)
+{
+	yii_di_lazyproxy *proxy = yii_di_lazyproxy_fetch(object TSRMLS_CC);
+
+	*table = &proxy->locator;
+	*n = 4;
+
+	return zend_std_get_properties(object TSRMLS_CC);
+}
+#endif
+
+static HashTable *yii_di_lazyproxy_get_debug_info(zval *object, int *is_temp TSRMLS_DC)
+{
+	yii_di_lazyproxy *proxy = yii_di_lazyproxy_fetch(object TSRMLS_CC);
+
+	if (proxy->component && Z_OBJ_HT_P(proxy->component)->get_debug_info) {
+		return Z_OBJ_HT_P(proxy->component)->get_debug_info(proxy->component, is_temp TSRMLS_CC);
+	}
+
+	*is_temp = 0;
+	return yii_di_lazyproxy_get_properties(object TSRMLS_CC);
+}
+
+/**
+ * Cloning a proxy clones the component
+ */
+static zend_object_value yii_di_lazyproxy_clone_obj(zval *object TSRMLS_DC)
+{
+	zval *component = yii_di_lazyproxy_component(object TSRMLS_CC);
+
+	if (!component || !Z_OBJ_HT_P(component)->clone_obj) {
+		if (!EG(exception)) {
+			zend_error(E_ERROR, "Trying to clone an uncloneable object of class %s", component ? Z_OBJCE_P(component)->name : yii_di_lazyproxy_ce->name);
+		}
+		return zend_objects_clone_obj(object TSRMLS_CC);
+	}
+
+	return Z_OBJ_HT_P(component)->clone_obj(component TSRMLS_CC);
+}
+
+static int yii_di_lazyproxy_cast_object(zval *readobj, zval *retval, int type TSRMLS_DC)
+{
+	zval *component = yii_di_lazyproxy_component(readobj TSRMLS_CC);
+
+	if (!component) {
+		return FAILURE;
+	}
+
+	if (Z_OBJ_HT_P(component)->cast_object) {
+		return Z_OBJ_HT_P(component)->cast_object(component, retval, type TSRMLS_CC);
+	}
+
+	return zend_std_cast_object_tostring(component, retval, type TSRMLS_CC);
+}
+
+static int yii_di_lazyproxy_count_elements(zval *object, long *count TSRMLS_DC)
+{
+	zval *component = yii_di_lazyproxy_component(object TSRMLS_CC), *retval = NULL;
+
+	if (!component) {
+		return FAILURE;
+	}
+
+	if (Z_OBJ_HT_P(component)->count_elements) {
+		return Z_OBJ_HT_P(component)->count_elements(component, count TSRMLS_CC);
+	}
+
+	if (!instanceof_function(Z_OBJCE_P(component), spl_ce_Countable TSRMLS_CC)) {
+		return FAILURE;
+	}
+
+	zend_call_method_with_0_params(&component, NULL, NULL, "count", &retval);
+	if (!retval) {
+		return FAILURE;
+	}
+
+	convert_to_long(retval);
+	*count = Z_LVAL_P(retval);
+	zval_ptr_dtor(&retval);
+
+	return SUCCESS;
+}
+
+static void yii_di_lazyproxy_free_storage(void *object TSRMLS_DC)
+{
+	yii_di_lazyproxy *proxy = (yii_di_lazyproxy *) object;
+
+	if (proxy->locator) {
+		zval_ptr_dtor(&proxy->locator);
+	}
+	if (proxy->id) {
+		zval_ptr_dtor(&proxy->id);
+	}
+	if (proxy->definition) {
+		zval_ptr_dtor(&proxy->definition);
+	}
+	if (proxy->component) {
+		zval_ptr_dtor(&proxy->component);
+	}
+
+	zend_object_std_dtor(&proxy->std TSRMLS_CC);
+	efree(proxy);
+}
+
+static zend_object_value yii_di_lazyproxy_create_object(zend_class_entry *ce TSRMLS_DC)
+{
+	zend_object_value retval;
+	yii_di_lazyproxy *proxy = ecalloc(1, sizeof(yii_di_lazyproxy));
+
+	zend_object_std_init(&proxy->std, ce TSRMLS_CC);
+#if PHP_VERSION_ID >= 50400
+	object_properties_init(&proxy->std, ce);
+#endif
+
+	retval.handle = zend_objects_store_put(proxy, (zend_objects_store_dtor_t) zend_objects_destroy_object, yii_di_lazyproxy_free_storage, NULL TSRMLS_CC);
+	retval.handlers = &yii_di_lazyproxy_handlers;
+
+	return retval;
+}
+
+ZEPHIR_INIT_CLASS(yii_di_LazyProxy) {
+
+	ZEPHIR_REGISTER_CLASS(yii\\di, LazyProxy, yii, di_lazyproxy, yii_di_lazyproxy_method_entry, ZEND_ACC_FINAL_CLASS);
+
+	yii_di_lazyproxy_ce->create_object = yii_di_lazyproxy_create_object;
+
+	memcpy(&yii_di_lazyproxy_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+	yii_di_lazyproxy_handlers.get_method = yii_di_lazyproxy_get_method;
+	yii_di_lazyproxy_handlers.read_property = yii_di_lazyproxy_read_property;
+	yii_di_lazyproxy_handlers.write_property = yii_di_lazyproxy_write_property;
+	yii_di_lazyproxy_handlers.has_property = yii_di_lazyproxy_has_property;
+	yii_di_lazyproxy_handlers.unset_property = yii_di_lazyproxy_unset_property;
+	yii_di_lazyproxy_handlers.get_property_ptr_ptr = yii_di_lazyproxy_get_property_ptr_ptr;
+	yii_di_lazyproxy_handlers.read_dimension = yii_di_lazyproxy_read_dimension;
+	yii_di_lazyproxy_handlers.write_dimension = yii_di_lazyproxy_write_dimension;
+	yii_di_lazyproxy_handlers.has_dimension = yii_di_lazyproxy_has_dimension;
+	yii_di_lazyproxy_handlers.unset_dimension = yii_di_lazyproxy_unset_dimension;
+	yii_di_lazyproxy_handlers.get_properties = yii_di_lazyproxy_get_properties;
+	yii_di_lazyproxy_handlers.get_debug_info = yii_di_lazyproxy_get_debug_info;
+#if PHP_VERSION_ID >= 50400
+	yii_di_lazyproxy_handlers.get_gc = yii_di_lazyproxy_get_gc;
+#endif
+	yii_di_lazyproxy_handlers.clone_obj = yii_di_lazyproxy_clone_obj;
+	yii_di_lazyproxy_handlers.cast_object = yii_di_lazyproxy_cast_object;
+	yii_di_lazyproxy_handlers.count_elements = yii_di_lazyproxy_count_elements;
+
+	return SUCCESS;
+
+}
+
+/**
+ * Creates a proxy for a component of the given locator.
+ * @param ServiceLocator $locator the locator owning the component
+ * @param string $id the component ID
+ * @param string|array $definition the component definition passed to [[BaseYii::createObject()]]
+ * @return LazyProxy the proxy
+ */
+PHP_METHOD(yii_di_LazyProxy, create) {
+
+	zval *locator, *id, *definition;
+	yii_di_lazyproxy *proxy;
+
+	zephir_fetch_params(0, 3, 0, &locator, &id, &definition);
+
+	if (Z_TYPE_P(locator) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(locator), yii_di_servicelocator_ce TSRMLS_CC)) {
+		zend_throw_exception_ex(yii_base_invalidparamexception_ce, 0 TSRMLS_CC, "Parameter 'locator' must be an instance of 'yii\\di\\ServiceLocator'");
+		return;
+	}
+
+	object_init_ex(return_value, yii_di_lazyproxy_ce);
+	proxy = yii_di_lazyproxy_fetch(return_value TSRMLS_CC);
+
+	Z_ADDREF_P(locator);
+	proxy->locator = locator;
+
+	MAKE_STD_ZVAL(proxy->id);
+	ZVAL_ZVAL(proxy->id, id, 1, 0);
+	convert_to_string(proxy->id);
+
+	Z_ADDREF_P(definition);
+	proxy->definition = definition;
+
+}
+
+/**
+ * Returns the component behind a proxy, creating it if necessary.
+ * @param mixed $value a proxy or any other value
+ * @return mixed the component if `$value` is a proxy, `$value` itself otherwise
+ */
+PHP_METHOD(yii_di_LazyProxy, resolve) {
+
+	zval *value, *component;
+
+	zephir_fetch_params(0, 1, 0, &value);
+
+	if (Z_TYPE_P(value) != IS_OBJECT || Z_OBJCE_P(value) != yii_di_lazyproxy_ce) {
+		RETURN_ZVAL(value, 1, 0);
+	}
+
+	component = yii_di_lazyproxy_component(value TSRMLS_CC);
+	if (component) {
+		RETURN_ZVAL(component, 1, 0);
+	}
+
+}
+
+/**
+ * Returns a value indicating whether the component behind a proxy has been created.
+ * @param LazyProxy $proxy the proxy
+ * @return boolean whether the component has been created
+ */
+PHP_METHOD(yii_di_LazyProxy, isInitialized) {
+
+	zval *proxy;
+
+	zephir_fetch_params(0, 1, 0, &proxy);
+
+	if (Z_TYPE_P(proxy) != IS_OBJECT || Z_OBJCE_P(proxy) != yii_di_lazyproxy_ce) {
+		zend_throw_exception_ex(yii_base_invalidparamexception_ce, 0 TSRMLS_CC, "Parameter 'proxy' must be an instance of 'yii\\di\\LazyProxy'");
+		return;
+	}
+
+	RETURN_BOOL(yii_di_lazyproxy_fetch(proxy TSRMLS_CC)->component != NULL);
+
+}
@@ -0,0 +1,29 @@
+
+extern zend_class_entry *yii_di_lazyproxy_ce;
+
+ZEPHIR_INIT_CLASS(yii_di_LazyProxy);
+
+PHP_METHOD(yii_di_LazyProxy, create);
+PHP_METHOD(yii_di_LazyProxy, resolve);
+PHP_METHOD(yii_di_LazyProxy, isInitialized);
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_yii_di_lazyproxy_create, 0, 0, 3)
+	ZEND_ARG_OBJ_INFO(0, locator, yii\\di\\ServiceLocator, 0)
+	ZEND_ARG_INFO(0, id)
+	ZEND_ARG_INFO(0, definition)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_yii_di_lazyproxy_resolve, 0, 0, 1)
+	ZEND_ARG_INFO(0, value)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_yii_di_lazyproxy_isinitialized, 0, 0, 1)
+	ZEND_ARG_OBJ_INFO(0, proxy, yii\\di\\LazyProxy, 0)
+ZEND_END_ARG_INFO()
+
+ZEPHIR_INIT_FUNCS(yii_di_lazyproxy_method_entry) {
+	PHP_ME(yii_di_LazyProxy, create, arginfo_yii_di_lazyproxy_create, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
+	PHP_ME(yii_di_LazyProxy, resolve, arginfo_yii_di_lazyproxy_resolve, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
+	PHP_ME(yii_di_LazyProxy, isInitialized, arginfo_yii_di_lazyproxy_isinitialized, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
+  PHP_FE_END
+};
@@ -21,6 +21,7 @@
 #include "Zend/zend_closures.h"
 #include "kernel/exception.h"
 #include "kernel/concat.h"
+#include "kernel/filter.h"
 
 
 /**
@@ -796,7 +797,7 @@ PHP_METHOD(yii_helpers_ArrayHelper, multisort) {
 			ZEPHIR_INIT_VAR(_6);
 			object_init_ex(_6, yii_base_invalidparamexception_ce);
 			ZEPHIR_INIT_VAR(_7);
-			ZEPHIR_CONCAT_SVSVS(_7, "The length of ", direction, " parameter must be the same as that of ", keys, ".");
+			ZEPHIR_CONCAT_N(_7, 0, ZEPHIR_CONCAT_OP_S("The length of "), ZEPHIR_CONCAT_OP_V(direction), ZEPHIR_CONCAT_OP_S(" parameter must be the same as that of "), ZEPHIR_CONCAT_OP_V(keys), ZEPHIR_CONCAT_OP_S("."));
 			ZEPHIR_CALL_METHOD(NULL, _6, "__construct", NULL, _7);
 			zephir_check_call_status();
 			zephir_throw_exception_debug(_6, "yii/helpers/ArrayHelper.zep", 496 TSRMLS_CC);
@@ -820,7 +821,7 @@ PHP_METHOD(yii_helpers_ArrayHelper, multisort) {
 			ZEPHIR_INIT_LNVAR(_6);
 			object_init_ex(_6, yii_base_invalidparamexception_ce);
 			ZEPHIR_INIT_LNVAR(_7);
-			ZEPHIR_CONCAT_SVSVS(_7, "The length of ", sortFlag, " parameter must be the same as that of ", keys, ".");
+			ZEPHIR_CONCAT_N(_7, 0, ZEPHIR_CONCAT_OP_S("The length of "), ZEPHIR_CONCAT_OP_V(sortFlag), ZEPHIR_CONCAT_OP_S(" parameter must be the same as that of "), ZEPHIR_CONCAT_OP_V(keys), ZEPHIR_CONCAT_OP_S("."));
 			ZEPHIR_CALL_METHOD(NULL, _6, "__construct", NULL, _7);
 			zephir_check_call_status();
 			zephir_throw_exception_debug(_6, "yii/helpers/ArrayHelper.zep", 506 TSRMLS_CC);
@@ -875,7 +876,6 @@ PHP_METHOD(yii_helpers_ArrayHelper, htmlEncode) {
 
 	zephir_fcall_cache_entry *_9 = NULL;
 	int ZEPHIR_LAST_CALL_STATUS;
-	zephir_nts_static zephir_fcall_cache_entry *_7 = NULL;
 	HashTable *_3;
 	HashPosition _2;
 	zend_bool valuesOnly, _5;
@@ -920,16 +920,21 @@ PHP_METHOD(yii_helpers_ArrayHelper, htmlEncode) {
 		if (_5) {
 			ZEPHIR_SINIT_NVAR(_6);
 			ZVAL_LONG(&_6, 3);
-			ZEPHIR_CALL_FUNCTION(&new_key, "htmlspecialchars", &_7, key, &_6, charset);
-			zephir_check_call_status();
+			ZEPHIR_INIT_NVAR(new_key);
+			zephir_escape_html(new_key, key, &_6, charset TSRMLS_CC);
 		} else {
 			ZEPHIR_CPY_WRT(new_key, key);
 		}
 		if (Z_TYPE_P(value) == IS_STRING) {
+			/* Strings without special characters are shared, not copied */
+			if (zephir_is_html_safe(Z_STRVAL_P(value), Z_STRLEN_P(value), 3)) {
+				zephir_array_update_zval(&d, key, &value, PH_COPY | PH_SEPARATE);
+				continue;
+			}
 			ZEPHIR_SINIT_NVAR(_6);
 			ZVAL_LONG(&_6, 3);
-			ZEPHIR_CALL_FUNCTION(&_8, "htmlspecialchars", &_7, value, &_6, charset);
-			zephir_check_call_status();
+			ZEPHIR_INIT_NVAR(_8);
+			zephir_escape_html(_8, value, &_6, charset TSRMLS_CC);
 			zephir_array_update_zval(&d, key, &_8, PH_COPY | PH_SEPARATE);
 		} else {
 			ZEPHIR_CPY_WRT(new_value, value);
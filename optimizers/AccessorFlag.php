@@ -0,0 +1,44 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompilerException;
+use Zephir\CompiledExpression;
+use Zephir\Optimizers\OptimizerAbstract;
+
+/**
+ * AccessorFlag
+ *
+ * Compiles has_getter() and has_setter() to a probe of the accessor table of the object's class:
+ *
+ *   if has_setter(this, name) {  // the class declares a non-private set<name>() method
+ */
+abstract class AccessorFlag extends OptimizerAbstract
+{
+    /**
+     * ZEPHIR_ACCESSOR_* flag tested
+     */
+    protected $flag;
+
+    /**
+     * @param array $expression
+     * @param Call $call
+     * @param CompilationContext $context
+     * @return CompiledExpression
+     * @throws CompilerException
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (!isset($expression['parameters']) || count($expression['parameters']) != 2) {
+            throw new CompilerException("'" . $expression['name'] . "' requires two parameters", $expression);
+        }
+
+        $resolvedParams = $call->getReadOnlyResolvedParams($expression['parameters'], $context, $expression);
+
+        $context->headersManager->add('kernel/object');
+
+        return new CompiledExpression('bool', '(zephir_accessor_flags(' . $resolvedParams[0] . ', ' . $resolvedParams[1] . ' TSRMLS_CC) & ' . $this->flag . ')', $expression);
+    }
+}
@@ -0,0 +1,58 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompilerException;
+use Zephir\CompiledExpression;
+use Zephir\Optimizers\OptimizerAbstract;
+
+/**
+ * AccessorGetOptimizer
+ *
+ * Compiles accessor_get(result, object, name) to a direct call of the getter found in the accessor
+ * table of the object's class. Evaluates to false, leaving result untouched, when there is no getter:
+ *
+ *   if accessor_get(value, this, name) {
+ *       return value;
+ *   }
+ */
+class AccessorGetOptimizer extends OptimizerAbstract
+{
+    /**
+     * @param array $expression
+     * @param Call $call
+     * @param CompilationContext $context
+     * @return CompiledExpression
+     * @throws CompilerException
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (!isset($expression['parameters']) || count($expression['parameters']) != 3) {
+            throw new CompilerException("'accessor_get' requires three parameters", $expression);
+        }
+
+        $parameters = $expression['parameters'];
+
+        $result = array_shift($parameters);
+        if ($result['parameter']['type'] != 'variable') {
+            throw new CompilerException("The first parameter of 'accessor_get' must be a variable", $expression);
+        }
+
+        $resultVariable = $context->symbolTable->getVariableForWrite($result['parameter']['value'], $context, $expression);
+        if ($resultVariable->getType() != 'variable') {
+            throw new CompilerException("'accessor_get' can only write to variant variables", $expression);
+        }
+
+        $resolvedParams = $call->getReadOnlyResolvedParams($parameters, $context, $expression);
+
+        $resultVariable->setIsInitialized(true, $context, $expression);
+
+        $context->headersManager->add('kernel/memory');
+        $context->headersManager->add('kernel/object');
+        $context->codePrinter->output('ZEPHIR_OBSERVE_OR_NULLIFY_PPZV(&' . $resultVariable->getName() . ');');
+
+        return new CompiledExpression('bool', 'zephir_accessor_get(&' . $resultVariable->getName() . ', ' . $resolvedParams[0] . ', ' . $resolvedParams[1] . ' TSRMLS_CC)', $expression);
+    }
+}
@@ -0,0 +1,42 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompilerException;
+use Zephir\CompiledExpression;
+use Zephir\Optimizers\OptimizerAbstract;
+
+/**
+ * AccessorSetOptimizer
+ *
+ * Compiles accessor_set(object, name, value) to a direct call of the setter found in the accessor
+ * table of the object's class. Evaluates to false when there is no setter:
+ *
+ *   if accessor_set(this, name, value) {
+ *       return;
+ *   }
+ */
+class AccessorSetOptimizer extends OptimizerAbstract
+{
+    /**
+     * @param array $expression
+     * @param Call $call
+     * @param CompilationContext $context
+     * @return CompiledExpression
+     * @throws CompilerException
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (!isset($expression['parameters']) || count($expression['parameters']) != 3) {
+            throw new CompilerException("'accessor_set' requires three parameters", $expression);
+        }
+
+        $resolvedParams = $call->getReadOnlyResolvedParams($expression['parameters'], $context, $expression);
+
+        $context->headersManager->add('kernel/object');
+
+        return new CompiledExpression('bool', 'zephir_accessor_set(' . $resolvedParams[0] . ', ' . $resolvedParams[1] . ', ' . $resolvedParams[2] . ' TSRMLS_CC)', $expression);
+    }
+}
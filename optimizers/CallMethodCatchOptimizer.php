@@ -0,0 +1,66 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompilerException;
+use Zephir\CompiledExpression;
+use Zephir\Optimizers\OptimizerAbstract;
+
+/**
+ * CallMethodCatchOptimizer
+ *
+ * Compiles call_method_catch(result, exception, object, method, params) to a method call catching the
+ * exception it throws, for the code that has to clean up before the exception propagates. Evaluates to
+ * false when an exception was caught, which [[rethrow()]] throws again unchanged:
+ *
+ *   if !call_method_catch(value, exception, this, "get", [id]) {
+ *       // clean up
+ *       rethrow(exception);
+ *       return null;
+ *   }
+ */
+class CallMethodCatchOptimizer extends OptimizerAbstract
+{
+    /**
+     * @param array $expression
+     * @param Call $call
+     * @param CompilationContext $context
+     * @return CompiledExpression
+     * @throws CompilerException
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (!isset($expression['parameters']) || count($expression['parameters']) != 5) {
+            throw new CompilerException("'call_method_catch' requires five parameters", $expression);
+        }
+
+        $parameters = $expression['parameters'];
+
+        $variables = array();
+        foreach (array('first', 'second') as $position) {
+            $parameter = array_shift($parameters);
+            if ($parameter['parameter']['type'] != 'variable') {
+                throw new CompilerException("The " . $position . " parameter of 'call_method_catch' must be a variable", $expression);
+            }
+
+            $variable = $context->symbolTable->getVariableForWrite($parameter['parameter']['value'], $context, $expression);
+            if ($variable->getType() != 'variable') {
+                throw new CompilerException("'call_method_catch' can only write to variant variables", $expression);
+            }
+            $variables[] = $variable;
+        }
+
+        $resolvedParams = $call->getReadOnlyResolvedParams($parameters, $context, $expression);
+
+        $context->headersManager->add('kernel/memory');
+        $context->headersManager->add('kernel/fcall');
+        foreach ($variables as $variable) {
+            $variable->setIsInitialized(true, $context, $expression);
+            $context->codePrinter->output('ZEPHIR_OBSERVE_OR_NULLIFY_PPZV(&' . $variable->getName() . ');');
+        }
+
+        return new CompiledExpression('bool', '(zephir_call_method_catch(&' . $variables[0]->getName() . ', &' . $variables[1]->getName() . ', ' . join(', ', $resolvedParams) . ' TSRMLS_CC) == SUCCESS)', $expression);
+    }
+}
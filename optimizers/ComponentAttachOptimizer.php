@@ -0,0 +1,19 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentAttachOptimizer
+ *
+ * component_attach(component, name, behavior): stores the behavior under name
+ */
+class ComponentAttachOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_attach';
+
+    protected $parameters = 3;
+
+    protected $type = 'null';
+}
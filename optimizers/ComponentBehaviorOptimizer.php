@@ -0,0 +1,19 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentBehaviorOptimizer
+ *
+ * component_behavior(result, component, name): result = the named behavior, false if there is none
+ */
+class ComponentBehaviorOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_behavior';
+
+    protected $parameters = 3;
+
+    protected $result = true;
+}
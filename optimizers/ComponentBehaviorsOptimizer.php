@@ -0,0 +1,19 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentBehaviorsOptimizer
+ *
+ * component_behaviors(result, component): result = the behaviors or null, true if there is any
+ */
+class ComponentBehaviorsOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_behaviors';
+
+    protected $parameters = 2;
+
+    protected $result = true;
+}
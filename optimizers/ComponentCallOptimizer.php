@@ -0,0 +1,19 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentCallOptimizer
+ *
+ * component_call(result, component, name, params): calls the method of the first behavior having it, false if none has
+ */
+class ComponentCallOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_call';
+
+    protected $parameters = 4;
+
+    protected $result = true;
+}
@@ -0,0 +1,19 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentDetachOptimizer
+ *
+ * component_detach(component, name): removes the named behavior
+ */
+class ComponentDetachOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_detach';
+
+    protected $parameters = 2;
+
+    protected $type = 'null';
+}
@@ -0,0 +1,17 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentEnsureOptimizer
+ *
+ * component_ensure(component): marks the behaviors as ensured, true the first time
+ */
+class ComponentEnsureOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_ensure';
+
+    protected $parameters = 1;
+}
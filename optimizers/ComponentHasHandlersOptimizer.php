@@ -0,0 +1,17 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentHasHandlersOptimizer
+ *
+ * component_has_handlers(component, name): true if any handler is attached to the event
+ */
+class ComponentHasHandlersOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_has_handlers';
+
+    protected $parameters = 2;
+}
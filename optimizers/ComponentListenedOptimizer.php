@@ -0,0 +1,18 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentListenedOptimizer
+ *
+ * component_listened(component, name): false if no component nor class has a handler for the event,
+ * once the behaviors of the component are ensured
+ */
+class ComponentListenedOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_listened';
+
+    protected $parameters = 2;
+}
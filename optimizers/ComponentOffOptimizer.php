@@ -0,0 +1,17 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentOffOptimizer
+ *
+ * component_off(component, name, handler): detaches the handler, or every handler when it is null
+ */
+class ComponentOffOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_off';
+
+    protected $parameters = 3;
+}
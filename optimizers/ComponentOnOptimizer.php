@@ -0,0 +1,19 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentOnOptimizer
+ *
+ * component_on(component, name, handler, data, append): attaches [handler, data] to the event
+ */
+class ComponentOnOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_on';
+
+    protected $parameters = 5;
+
+    protected $type = 'null';
+}
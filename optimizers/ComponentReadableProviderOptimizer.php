@@ -0,0 +1,21 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentReadableProviderOptimizer
+ *
+ * component_readable_provider(result, component, name): result = the first behavior with a readable property name
+ */
+class ComponentReadableProviderOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_provider';
+
+    protected $parameters = 3;
+
+    protected $result = true;
+
+    protected $arguments = ', YII_COMPONENT_READABLE';
+}
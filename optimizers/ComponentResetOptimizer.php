@@ -0,0 +1,19 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentResetOptimizer
+ *
+ * component_reset(component): drops the handlers and behaviors
+ */
+class ComponentResetOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_reset';
+
+    protected $parameters = 1;
+
+    protected $type = 'null';
+}
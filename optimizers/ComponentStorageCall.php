@@ -0,0 +1,96 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompilerException;
+use Zephir\CompiledExpression;
+use Zephir\Optimizers\OptimizerAbstract;
+
+/**
+ * ComponentStorageCall
+ *
+ * Compiles the component_* functions to the native storage of the event handlers and behaviors
+ * of a component (fixed/base/componentstorageinterface.c):
+ *
+ *   if component_ensure(this) {                    // first call of ensureBehaviors()
+ *   if component_behavior(behavior, this, name) {  // behavior = the named behavior, if attached
+ *   component_on(this, name, handler, data, append);
+ *
+ * The functions fetching a value take the variable to write as their first parameter.
+ */
+abstract class ComponentStorageCall extends OptimizerAbstract
+{
+    /**
+     * Native function emitted
+     */
+    protected $function;
+
+    /**
+     * Number of parameters, the variable written included
+     */
+    protected $parameters;
+
+    /**
+     * Whether the first parameter is a variable written by the function
+     */
+    protected $result = false;
+
+    /**
+     * Type of the expression, 'bool' or 'null' for statements
+     */
+    protected $type = 'bool';
+
+    /**
+     * C arguments passed after the parameters
+     */
+    protected $arguments = '';
+
+    /**
+     * @param array $expression
+     * @param Call $call
+     * @param CompilationContext $context
+     * @return CompiledExpression
+     * @throws CompilerException
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (!isset($expression['parameters']) || count($expression['parameters']) != $this->parameters) {
+            throw new CompilerException("'" . $expression['name'] . "' requires " . $this->parameters . " parameters", $expression);
+        }
+
+        $parameters = $expression['parameters'];
+
+        $code = $this->function . '(';
+        if ($this->result) {
+            $result = array_shift($parameters);
+            if ($result['parameter']['type'] != 'variable') {
+                throw new CompilerException("The first parameter of '" . $expression['name'] . "' must be a variable", $expression);
+            }
+
+            $resultVariable = $context->symbolTable->getVariableForWrite($result['parameter']['value'], $context, $expression);
+            if ($resultVariable->getType() != 'variable') {
+                throw new CompilerException("'" . $expression['name'] . "' can only write to variant variables", $expression);
+            }
+
+            $code .= '&' . $resultVariable->getName() . ', ';
+        }
+
+        $resolvedParams = $call->getReadOnlyResolvedParams($parameters, $context, $expression);
+        $code .= join(', ', $resolvedParams) . $this->arguments . ' TSRMLS_CC)';
+
+        if ($this->result) {
+            $resultVariable->setIsInitialized(true, $context, $expression);
+            $context->headersManager->add('kernel/memory');
+            $context->codePrinter->output('ZEPHIR_OBSERVE_OR_NULLIFY_PPZV(&' . $resultVariable->getName() . ');');
+        }
+
+        if ($this->type == 'null') {
+            $context->codePrinter->output($code . ';');
+            return new CompiledExpression('null', 'null', $expression);
+        }
+
+        return new CompiledExpression('bool', $code, $expression);
+    }
+}
@@ -0,0 +1,17 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentTriggerOptimizer
+ *
+ * component_trigger(component, name, event): calls the handlers of the event, true if one of them handled it
+ */
+class ComponentTriggerOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_trigger';
+
+    protected $parameters = 3;
+}
@@ -0,0 +1,21 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * ComponentWritableProviderOptimizer
+ *
+ * component_writable_provider(result, component, name): result = the first behavior with a writable property name
+ */
+class ComponentWritableProviderOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_provider';
+
+    protected $parameters = 3;
+
+    protected $result = true;
+
+    protected $arguments = ', YII_COMPONENT_WRITABLE';
+}
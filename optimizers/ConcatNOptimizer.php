@@ -0,0 +1,78 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompilerException;
+use Zephir\CompiledExpression;
+use Zephir\Optimizers\OptimizerAbstract;
+
+/**
+ * ConcatNOptimizer
+ *
+ * Compiles concat_n(...) to the n-ary kernel concatenation, which measures every operand and
+ * writes the result with a single allocation whatever the number of operands:
+ *
+ *   let message = concat_n("Getting unknown property: ", get_class(this), "::", name);
+ *
+ * String literals are passed as C strings, any other operand as a zval.
+ */
+class ConcatNOptimizer extends OptimizerAbstract
+{
+    /**
+     * @param array $expression
+     * @param Call $call
+     * @param CompilationContext $context
+     * @return CompiledExpression
+     * @throws CompilerException
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (!isset($expression['parameters']) || count($expression['parameters']) < 2) {
+            throw new CompilerException("'concat_n' requires at least two parameters", $expression);
+        }
+
+        $call->processExpectedReturn($context);
+
+        $symbolVariable = $call->getSymbolVariable();
+        if (!$symbolVariable) {
+            throw new CompilerException("'concat_n' must be assigned to a variable", $expression);
+        }
+
+        if ($symbolVariable->getType() != 'variable') {
+            throw new CompilerException("Returned values by functions can only be assigned to variant variables", $expression);
+        }
+
+        $values = array();
+        foreach ($expression['parameters'] as $parameter) {
+            if ($parameter['parameter']['type'] == 'variable' && $parameter['parameter']['value'] == $symbolVariable->getName()) {
+                throw new CompilerException("'concat_n' cannot read the variable it is assigned to, use '.=' instead", $expression);
+            }
+            if ($parameter['parameter']['type'] != 'string') {
+                $values[] = $parameter;
+            }
+        }
+
+        /* Operands are resolved before the result is initialized */
+        $resolvedParams = count($values) ? $call->getReadOnlyResolvedParams($values, $context, $expression) : array();
+
+        $operands = array();
+        foreach ($expression['parameters'] as $parameter) {
+            if ($parameter['parameter']['type'] == 'string') {
+                $operands[] = 'ZEPHIR_CONCAT_OP_S("' . $parameter['parameter']['value'] . '")';
+            } else {
+                $operands[] = 'ZEPHIR_CONCAT_OP_V(' . array_shift($resolvedParams) . ')';
+            }
+        }
+
+        if ($call->mustInitSymbolVariable()) {
+            $symbolVariable->initVariant($context);
+        }
+
+        $context->headersManager->add('kernel/operators');
+        $context->codePrinter->output('ZEPHIR_CONCAT_N(' . $symbolVariable->getName() . ', 0, ' . join(', ', $operands) . ');');
+
+        return new CompiledExpression('variable', $symbolVariable->getRealName(), $expression);
+    }
+}
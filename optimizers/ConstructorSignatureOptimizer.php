@@ -0,0 +1,56 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompilerException;
+use Zephir\CompiledExpression;
+use Zephir\Optimizers\OptimizerAbstract;
+
+/**
+ * ConstructorSignatureOptimizer
+ *
+ * Compiles constructor_signature(className) to the kernel function returning the constructor
+ * signature cached in persistent memory, or false when the class must be reflected on:
+ *
+ *   let signature = constructor_signature(className);  // [[name, hasDefault, default, className], ...]
+ */
+class ConstructorSignatureOptimizer extends OptimizerAbstract
+{
+    /**
+     * @param array $expression
+     * @param Call $call
+     * @param CompilationContext $context
+     * @return CompiledExpression
+     * @throws CompilerException
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (!isset($expression['parameters']) || count($expression['parameters']) != 1) {
+            throw new CompilerException("'constructor_signature' requires one parameter", $expression);
+        }
+
+        $call->processExpectedReturn($context);
+
+        $symbolVariable = $call->getSymbolVariable();
+        if (!$symbolVariable) {
+            throw new CompilerException("'constructor_signature' must be assigned to a variable", $expression);
+        }
+
+        if ($symbolVariable->getType() != 'variable') {
+            throw new CompilerException("Returned values by functions can only be assigned to variant variables", $expression);
+        }
+
+        if ($call->mustInitSymbolVariable()) {
+            $symbolVariable->initVariant($context);
+        }
+
+        $resolvedParams = $call->getReadOnlyResolvedParams($expression['parameters'], $context, $expression);
+
+        $context->headersManager->add('kernel/object');
+        $context->codePrinter->output('zephir_constructor_signature(' . $symbolVariable->getName() . ', ' . $resolvedParams[0] . ' TSRMLS_CC);');
+
+        return new CompiledExpression('variable', $symbolVariable->getRealName(), $expression);
+    }
+}
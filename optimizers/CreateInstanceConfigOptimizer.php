@@ -0,0 +1,56 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompilerException;
+use Zephir\CompiledExpression;
+use Zephir\Optimizers\OptimizerAbstract;
+
+/**
+ * CreateInstanceConfigOptimizer
+ *
+ * Compiles create_instance_config(className, params, properties) to the kernel function that
+ * calls the constructor of the class directly and then assigns the properties:
+ *
+ *   let object = create_instance_config(className, [db], ["charset": "utf8"]);
+ */
+class CreateInstanceConfigOptimizer extends OptimizerAbstract
+{
+    /**
+     * @param array $expression
+     * @param Call $call
+     * @param CompilationContext $context
+     * @return CompiledExpression
+     * @throws CompilerException
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (!isset($expression['parameters']) || count($expression['parameters']) != 3) {
+            throw new CompilerException("'create_instance_config' requires three parameters", $expression);
+        }
+
+        $call->processExpectedReturn($context);
+
+        $symbolVariable = $call->getSymbolVariable();
+        if (!$symbolVariable) {
+            throw new CompilerException("'create_instance_config' must be assigned to a variable", $expression);
+        }
+
+        if ($symbolVariable->getType() != 'variable') {
+            throw new CompilerException("Returned values by functions can only be assigned to variant variables", $expression);
+        }
+
+        if ($call->mustInitSymbolVariable()) {
+            $symbolVariable->initVariant($context);
+        }
+
+        $resolvedParams = $call->getReadOnlyResolvedParams($expression['parameters'], $context, $expression);
+
+        $context->headersManager->add('kernel/object');
+        $context->codePrinter->output('zephir_create_instance_config(' . $symbolVariable->getName() . ', ' . $resolvedParams[0] . ', ' . $resolvedParams[1] . ', ' . $resolvedParams[2] . ' TSRMLS_CC);');
+
+        return new CompiledExpression('variable', $symbolVariable->getRealName(), $expression);
+    }
+}
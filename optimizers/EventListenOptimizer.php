@@ -0,0 +1,19 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/ComponentStorageCall.php';
+
+/**
+ * EventListenOptimizer
+ *
+ * event_listen(name, delta): adds delta to the number of handlers attached to the event name anywhere
+ */
+class EventListenOptimizer extends ComponentStorageCall
+{
+    protected $function = 'yii_base_componentstorage_listen';
+
+    protected $parameters = 2;
+
+    protected $type = 'null';
+}
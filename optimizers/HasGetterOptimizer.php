@@ -0,0 +1,15 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/AccessorFlag.php';
+
+/**
+ * HasGetterOptimizer
+ *
+ * has_getter(object, name): whether the class of object has a getter for the magic property name
+ */
+class HasGetterOptimizer extends AccessorFlag
+{
+    protected $flag = 'ZEPHIR_ACCESSOR_GETTER';
+}
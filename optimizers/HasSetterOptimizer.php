@@ -0,0 +1,15 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/AccessorFlag.php';
+
+/**
+ * HasSetterOptimizer
+ *
+ * has_setter(object, name): whether the class of object has a setter for the magic property name
+ */
+class HasSetterOptimizer extends AccessorFlag
+{
+    protected $flag = 'ZEPHIR_ACCESSOR_SETTER';
+}
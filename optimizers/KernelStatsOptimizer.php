@@ -0,0 +1,60 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompilerException;
+use Zephir\CompiledExpression;
+use Zephir\Optimizers\OptimizerAbstract;
+
+/**
+ * KernelStatsOptimizer
+ *
+ * Compiles kernel_stats([reset]) to the kernel function exporting the kernel counters:
+ *
+ *   let stats = kernel_stats(true);  // read the counters and clear them
+ */
+class KernelStatsOptimizer extends OptimizerAbstract
+{
+    /**
+     * @param array $expression
+     * @param Call $call
+     * @param CompilationContext $context
+     * @return CompiledExpression
+     * @throws CompilerException
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (isset($expression['parameters']) && count($expression['parameters']) > 1) {
+            throw new CompilerException("'kernel_stats' accepts at most one parameter", $expression);
+        }
+
+        $call->processExpectedReturn($context);
+
+        $symbolVariable = $call->getSymbolVariable();
+        if (!$symbolVariable) {
+            throw new CompilerException("'kernel_stats' must be assigned to a variable", $expression);
+        }
+
+        if ($symbolVariable->getType() != 'variable') {
+            throw new CompilerException("Returned values by functions can only be assigned to variant variables", $expression);
+        }
+
+        if ($call->mustInitSymbolVariable()) {
+            $symbolVariable->initVariant($context);
+        }
+
+        $reset = '0';
+        if (isset($expression['parameters'])) {
+            $resolvedParams = $call->getReadOnlyResolvedParams($expression['parameters'], $context, $expression);
+            $context->headersManager->add('kernel/operators');
+            $reset = 'zephir_is_true(' . $resolvedParams[0] . ')';
+        }
+
+        $context->headersManager->add('kernel/memory');
+        $context->codePrinter->output('zephir_kernel_stats(' . $symbolVariable->getName() . ', ' . $reset . ' TSRMLS_CC);');
+
+        return new CompiledExpression('variable', $symbolVariable->getRealName(), $expression);
+    }
+}
@@ -0,0 +1,37 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompilerException;
+use Zephir\CompiledExpression;
+use Zephir\Optimizers\OptimizerAbstract;
+
+/**
+ * MonotonicTimeOptimizer
+ *
+ * Compiles monotonic_time() to the kernel clock, a time in seconds that system time changes do not affect:
+ *
+ *   let start = monotonic_time();
+ */
+class MonotonicTimeOptimizer extends OptimizerAbstract
+{
+    /**
+     * @param array $expression
+     * @param Call $call
+     * @param CompilationContext $context
+     * @return CompiledExpression
+     * @throws CompilerException
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (isset($expression['parameters'])) {
+            throw new CompilerException("'monotonic_time' does not accept parameters", $expression);
+        }
+
+        $context->headersManager->add('kernel/main');
+
+        return new CompiledExpression('double', 'zephir_monotonic_time()', $expression);
+    }
+}
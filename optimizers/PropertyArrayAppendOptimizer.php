@@ -0,0 +1,15 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/PropertyArrayMutation.php';
+
+/**
+ * PropertyArrayAppendOptimizer
+ *
+ * property_array_append(object, "property", value, key...): object->property[key...][] = value
+ */
+class PropertyArrayAppendOptimizer extends PropertyArrayMutation
+{
+    protected $function = 'zephir_property_array_append';
+}
@@ -0,0 +1,105 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompilerException;
+use Zephir\CompiledExpression;
+use Zephir\Optimizers\OptimizerAbstract;
+
+/**
+ * PropertyArrayMutation
+ *
+ * Compiles the property_array_* and static_property_array_* functions to the kernel
+ * primitives that modify array properties in place:
+ *
+ *   property_array_append(this, "_events", handler, name);  // this->_events[name][] = handler
+ *   static_property_array_unset("_events", name, class);     // unset self::_events[name][class]
+ *
+ * The property name must be a literal, static properties belong to the class being compiled.
+ */
+abstract class PropertyArrayMutation extends OptimizerAbstract
+{
+    /**
+     * Kernel function emitted
+     */
+    protected $function;
+
+    /**
+     * Whether the property is a static property of the class being compiled
+     */
+    protected $static = false;
+
+    /**
+     * Whether a value is passed before the keys
+     */
+    protected $hasValue = true;
+
+    /**
+     * Minimum number of keys in the path
+     */
+    protected $minKeys = 0;
+
+    /**
+     * @param array $expression
+     * @param Call $call
+     * @param CompilationContext $context
+     * @return CompiledExpression
+     * @throws CompilerException
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (!isset($expression['parameters'])) {
+            throw new CompilerException("'" . $expression['name'] . "' requires parameters", $expression);
+        }
+
+        $parameters = $expression['parameters'];
+
+        $arguments = array();
+        if (!$this->static) {
+            $arguments[] = array_shift($parameters);
+        }
+
+        $property = array_shift($parameters);
+        if (!$property || $property['parameter']['type'] != 'string') {
+            throw new CompilerException("'" . $expression['name'] . "' requires a literal property name", $expression);
+        }
+
+        if ($this->hasValue) {
+            if (!count($parameters)) {
+                throw new CompilerException("'" . $expression['name'] . "' requires a value", $expression);
+            }
+            $arguments[] = array_shift($parameters);
+        }
+
+        $keysCount = count($parameters);
+        if ($keysCount < $this->minKeys) {
+            throw new CompilerException("'" . $expression['name'] . "' requires at least " . $this->minKeys . " key(s)", $expression);
+        }
+
+        $resolvedParams = $call->getReadOnlyResolvedParams(array_merge($arguments, $parameters), $context, $expression);
+
+        $context->headersManager->add('kernel/object');
+
+        if ($this->static) {
+            $code = $this->function . '(' . $context->classDefinition->getClassEntry();
+        } else {
+            $code = $this->function . '(' . array_shift($resolvedParams);
+        }
+
+        $code .= ', SL("' . $property['parameter']['value'] . '")';
+        if ($this->hasValue) {
+            $code .= ', ' . array_shift($resolvedParams);
+        }
+
+        $code .= ' TSRMLS_CC, ' . $keysCount;
+        foreach ($resolvedParams as $key) {
+            $code .= ', ' . $key;
+        }
+
+        $context->codePrinter->output($code . ');');
+
+        return new CompiledExpression('null', 'null', $expression);
+    }
+}
@@ -0,0 +1,15 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/PropertyArrayMutation.php';
+
+/**
+ * PropertyArrayPrependOptimizer
+ *
+ * property_array_prepend(object, "property", value, key...): array_unshift(object->property[key...], value)
+ */
+class PropertyArrayPrependOptimizer extends PropertyArrayMutation
+{
+    protected $function = 'zephir_property_array_prepend';
+}
@@ -0,0 +1,19 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/PropertyArrayMutation.php';
+
+/**
+ * PropertyArrayUnsetOptimizer
+ *
+ * property_array_unset(object, "property", key...): unset object->property[key...]
+ */
+class PropertyArrayUnsetOptimizer extends PropertyArrayMutation
+{
+    protected $function = 'zephir_property_array_unset';
+
+    protected $hasValue = false;
+
+    protected $minKeys = 1;
+}
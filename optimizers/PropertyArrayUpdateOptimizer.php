@@ -0,0 +1,17 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/PropertyArrayMutation.php';
+
+/**
+ * PropertyArrayUpdateOptimizer
+ *
+ * property_array_update(object, "property", value, key...): object->property[key...] = value
+ */
+class PropertyArrayUpdateOptimizer extends PropertyArrayMutation
+{
+    protected $function = 'zephir_property_array_update';
+
+    protected $minKeys = 1;
+}
@@ -0,0 +1,43 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+use Zephir\Call;
+use Zephir\CompilationContext;
+use Zephir\CompilerException;
+use Zephir\CompiledExpression;
+use Zephir\Optimizers\OptimizerAbstract;
+
+/**
+ * RethrowOptimizer
+ *
+ * Compiles rethrow(exception) to throwing an exception caught by call_method_catch() again. Unlike the
+ * throw statement, the file and the line where the exception was raised are kept. The statement does not
+ * leave the method, it is to be followed by a return:
+ *
+ *   rethrow(exception);
+ *   return null;
+ */
+class RethrowOptimizer extends OptimizerAbstract
+{
+    /**
+     * @param array $expression
+     * @param Call $call
+     * @param CompilationContext $context
+     * @return CompiledExpression
+     * @throws CompilerException
+     */
+    public function optimize(array $expression, Call $call, CompilationContext $context)
+    {
+        if (!isset($expression['parameters']) || count($expression['parameters']) != 1) {
+            throw new CompilerException("'rethrow' requires one parameter", $expression);
+        }
+
+        $resolvedParams = $call->getReadOnlyResolvedParams($expression['parameters'], $context, $expression);
+
+        $context->headersManager->add('kernel/exception');
+        $context->codePrinter->output('zephir_throw_exception(' . $resolvedParams[0] . ' TSRMLS_CC);');
+
+        return new CompiledExpression('null', 'null', $expression);
+    }
+}
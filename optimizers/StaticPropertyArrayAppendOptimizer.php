@@ -0,0 +1,17 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/PropertyArrayMutation.php';
+
+/**
+ * StaticPropertyArrayAppendOptimizer
+ *
+ * static_property_array_append("property", value, key...): self::property[key...][] = value
+ */
+class StaticPropertyArrayAppendOptimizer extends PropertyArrayMutation
+{
+    protected $function = 'zephir_static_property_array_append';
+
+    protected $static = true;
+}
@@ -0,0 +1,17 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/PropertyArrayMutation.php';
+
+/**
+ * StaticPropertyArrayPrependOptimizer
+ *
+ * static_property_array_prepend("property", value, key...): array_unshift(self::property[key...], value)
+ */
+class StaticPropertyArrayPrependOptimizer extends PropertyArrayMutation
+{
+    protected $function = 'zephir_static_property_array_prepend';
+
+    protected $static = true;
+}
@@ -0,0 +1,21 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/PropertyArrayMutation.php';
+
+/**
+ * StaticPropertyArrayUnsetOptimizer
+ *
+ * static_property_array_unset("property", key...): unset self::property[key...]
+ */
+class StaticPropertyArrayUnsetOptimizer extends PropertyArrayMutation
+{
+    protected $function = 'zephir_static_property_array_unset';
+
+    protected $static = true;
+
+    protected $hasValue = false;
+
+    protected $minKeys = 1;
+}
@@ -0,0 +1,19 @@
+<?php
+
+namespace Zephir\Optimizers\FunctionCall;
+
+require_once __DIR__ . '/PropertyArrayMutation.php';
+
+/**
+ * StaticPropertyArrayUpdateOptimizer
+ *
+ * static_property_array_update("property", value, key...): self::property[key...] = value
+ */
+class StaticPropertyArrayUpdateOptimizer extends PropertyArrayMutation
+{
+    protected $function = 'zephir_static_property_array_update';
+
+    protected $static = true;
+
+    protected $minKeys = 1;
+}
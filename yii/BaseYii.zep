@@ -348,6 +348,8 @@ class BaseYii
      *
      * Using [[\yii\di\Container|dependency injection container]], this method can also identify
      * dependent objects, instantiate them and inject them into the newly created object.
+     * Types registered via [[\yii\di\Container::setPrototype()]] are created by cloning a prototype
+     * when neither constructor parameters nor configuration are given.
      *
      * @param string|array|callable $type the object type. This can be specified in one of the following forms:
      *
@@ -391,6 +393,61 @@ class BaseYii
         }
     }
 
+    /**
+     * Creates new objects of the same type, one for each of the given configurations.
+     *
+     * This is the bulk version of [[createObject()]]. The object type is resolved once by
+     * [[\yii\di\Container::getMany()]], which makes creating many small objects (e.g. models hydrated from
+     * a result set) much cheaper than calling [[createObject()]] for each of them.
+     *
+     * ```php
+     * $users = Yii::createObjects('app\models\User', $rows);
+     * $items = Yii::createObjects(['class' => 'app\models\Item', 'scenario' => 'report'], $rows);
+     * ```
+     *
+     * @param string|array|callable $type the object type, see [[createObject()]]. The name-value pairs of
+     * a configuration array are applied to every object before its own configuration.
+     * @param array $configs the lists of name-value pairs used to initialize the properties of each object.
+     * The keys are preserved in the returned array.
+     * @param array $params the constructor parameters
+     * @return array the created objects, indexed like `$configs`
+     * @throws InvalidConfigException if the configuration is invalid.
+     */
+    public static function createObjects(type, array configs, array params = []) -> array
+    {
+        var $class, key, config, $object, objects = [];
+
+        if typeof type == "string" {
+            let objects = $static::$container->getMany(type, configs, params);
+            return objects;
+        }
+
+        if typeof type == "array" && isset type["class"] {
+            let $class = type["class"];
+            unset type["class"];
+            let objects = $static::$container->getMany($class, configs, params, type);
+            return objects;
+        }
+
+        if is_callable(type, true) {
+            for key, config in configs {
+                let $object = call_user_func(type, params);
+                if !empty config {
+                    $static::configure($object, config);
+                }
+                let objects[key] = $object;
+            }
+            return objects;
+        }
+
+        if is_array(type) {
+            string text = "class";
+            throw new InvalidConfigException("Object configuration must be an array containing a \"". text ."\" element.");
+        } else {
+            throw new InvalidConfigException("Unsupported configuration type: " . gettype(type));
+        }
+    }
+
     /**
      * @return Logger message logger
      */
@@ -506,6 +563,26 @@ class BaseYii
         return "Powered by <a href=\"http://www.yiiframework.com/\" rel=\"external\">Yii Framework</a>";
     }
 
+    /**
+     * Returns the counters collected by the extension kernel since the process started
+     * or since the last reset.
+     *
+     * The result contains the number of memory frames grown and the maximum frame depth,
+     * the number of zvals observed and symbol tables created, the function cache hits and misses,
+     * the property lookups and inline cache hits, the concatenation allocations, the number of
+     * requests served and the usage of the frame arena. The counters are kept per process;
+     * thread-safe builds report them as zero.
+     *
+     * @param boolean $reset whether to clear the counters after reading them
+     * @return array the kernel counters indexed by name
+     */
+    public static function kernelStats(bool reset = false) -> array
+    {
+        var stats;
+        let stats = kernel_stats(reset);
+        return stats;
+    }
+
     /**
      * Translates a message to the specified language.
      *
@@ -94,16 +94,17 @@ use yii\BaseYii;
  * @author Qiang Xue <qiang.xue@gmail.com>
  * @since 2.0
  */
-class Component extends $Object
+class Component extends $Object implements ComponentStorageInterface
 {
+    // the attached event handlers (event name => handlers) and behaviors (behavior name => behavior)
+    // are kept in the native storage of the object, see ComponentStorageInterface
+
     /**
-     * @var array the attached event handlers (event name => handlers)
-     */
-    protected _events;
-    /**
-     * @var Behavior[] the attached behaviors (behavior name => behavior)
+     * @var array the behaviors declared by each class, as returned by [[behaviors()]] (class name => behaviors).
+     * Only declarations made of scalars and arrays are kept: behavior objects can only be attached to one
+     * component, and closures or other objects in a configuration belong to the instance that created them.
      */
-    protected _behaviors;
+    protected static _behaviorPlans = [];
 
     /**
      * Returns the value of a component property.
@@ -122,25 +123,25 @@ class Component extends $Object
      */
     public function __get(string name)
     {
-        var getter, setter;
-        let getter = "get". name,
-            setter = "set". name;
+        var value, message;
 
-        if method_exists(this, getter) {
-            return this->{getter}();
+        // getters and setters are looked up in a table built once per class
+        if accessor_get(value, this, name) {
+            return value;
         } else {
-            this->ensureBehaviors();
+            // the behavior providing the property is looked up once
             var behavior;
-            for behavior in this->_behaviors {
-                if behavior->canGetProperty(name) {
-                    return behavior->{name};
-                }
+            this->ensureBehaviors();
+            if component_readable_provider(behavior, this, name) {
+                return behavior->{name};
             }
         }
-        if method_exists(this, setter) {
-            throw new InvalidCallException("Getting write-only property: " . get_class(this) . "::" . name);
+        if has_setter(this, name) {
+            let message = concat_n("Getting write-only property: ", get_class(this), "::", name);
+            throw new InvalidCallException(message);
         } else {
-            throw new UnknownPropertyException("Getting unknown property: " . get_class(this) . "::" . name);
+            let message = concat_n("Getting unknown property: ", get_class(this), "::", name);
+            throw new UnknownPropertyException(message);
         }
     }
 
@@ -163,15 +164,10 @@ class Component extends $Object
      */
     public function __set(string name, value)
     {
-        var getter, setter, cmp_result;
-
-        let getter = "get". name,
-            setter = "set". name;
+        var cmp_result, message;
 
-        if method_exists(this, setter) {
+        if accessor_set(this, name, value) {
             // set property
-            this->{setter}(value);
-
             return;
         }
         else {
@@ -199,21 +195,21 @@ class Component extends $Object
                     return;
                 } else {
                     // behavior property
-                    this->ensureBehaviors();
                     var behavior;
-                    for behavior in this->_behaviors {
-                        if behavior->canSetProperty(name) {
-                            let behavior->{name} = value;
-                            return;
-                        }
+                    this->ensureBehaviors();
+                    if component_writable_provider(behavior, this, name) {
+                        let behavior->{name} = value;
+                        return;
                     }
                 }
             }
         }
-        if method_exists(this, getter) {
-            throw new InvalidCallException("Setting read-only property: " . get_class(this) . "::" . name);
+        if has_getter(this, name) {
+            let message = concat_n("Setting read-only property: ", get_class(this), "::", name);
+            throw new InvalidCallException(message);
         } else {
-            throw new UnknownPropertyException("Setting unknown property: " . get_class(this) . "::" . name);
+            let message = concat_n("Setting unknown property: ", get_class(this), "::", name);
+            throw new UnknownPropertyException(message);
         }
     }
 
@@ -231,19 +227,16 @@ class Component extends $Object
      */
     public function __isset(string name)
     {
-        var getter;
-        let getter = "get". name;
+        var value;
 
-        if method_exists(this, getter) {
-            return this->{getter}() !== null;
+        if accessor_get(value, this, name) {
+            return value !== null;
         } else {
             // behavior property
-            this->ensureBehaviors();
             var behavior;
-            for behavior in this->_behaviors {
-                if behavior->canGetProperty(name) {
-                    return behavior->{name} !== null;
-                }
+            this->ensureBehaviors();
+            if component_readable_provider(behavior, this, name) {
+                return behavior->{name} !== null;
             }
         }
 
@@ -264,25 +257,21 @@ class Component extends $Object
      */
     public function __unset(string $name)
     {
-        var setter;
-        let setter = "set". name;
-
-        if method_exists(this, setter) {
-            this->{setter}(null);
+        var value = null, message;
 
+        if accessor_set(this, name, value) {
             return;
         } else {
             // behavior property
-            this->ensureBehaviors();
             var behavior;
-            for behavior in this->_behaviors {
-                if behavior->canSetProperty(name) {
-                    let behavior->{name} = null;
-                    return;
-                }
+            this->ensureBehaviors();
+            if component_writable_provider(behavior, this, name) {
+                let behavior->{name} = null;
+                return;
             }
         }
-        throw new InvalidCallException("Unsetting an unknown or read-only property: " . get_class(this) . "::" . name);
+        let message = concat_n("Unsetting an unknown or read-only property: ", get_class(this), "::", name);
+        throw new InvalidCallException(message);
     }
 
     /**
@@ -300,15 +289,16 @@ class Component extends $Object
      */
     public function __call(string name, params)
     {
+        var result, message;
+
+        // the behavior method is looked up once and then called directly
         this->ensureBehaviors();
-        var $object;
-        for $object in this->_behaviors {
-            if $object->hasMethod(name) {
-                return call_user_func_array([$object, name], params);
-            }
+        if component_call(result, this, name, params) {
+            return result;
         }
 
-        throw new UnknownMethodException("Calling unknown method: " . get_class(this) . "::" . name ."()");
+        let message = concat_n("Calling unknown method: ", get_class(this), "::", name, "()");
+        throw new UnknownMethodException(message);
     }
 
     /**
@@ -317,8 +307,7 @@ class Component extends $Object
      */
     public function __clone()
     {
-        let this->_events = [];
-        let this->_behaviors = null;
+        component_reset(this);
     }
 
     /**
@@ -359,19 +348,21 @@ class Component extends $Object
      */
     public function canGetProperty(string name, bool checkVars = true, bool checkBehaviors = true)
     {
-        var getter;
-        let getter = "get" . name;
-
-        if method_exists(this, getter) || checkVars && property_exists(this, name) {
+        if has_getter(this, name) || checkVars && property_exists(this, name) {
             return true;
         }
 
         if checkBehaviors {
+            var behavior, behaviors;
             this->ensureBehaviors();
-            var behavior;
-            for behavior in this->_behaviors {
-                if behavior->canGetProperty(name, checkVars) {
-                    return true;
+            if checkVars {
+                return component_readable_provider(behavior, this, name);
+            }
+            if component_behaviors(behaviors, this) {
+                for behavior in behaviors {
+                    if behavior->canGetProperty(name, checkVars) {
+                        return true;
+                    }
                 }
             }
         }
@@ -396,19 +387,21 @@ class Component extends $Object
      */
     public function canSetProperty(string name, bool checkVars = true, bool checkBehaviors = true)
     {
-        var setter;
-        let setter = "set". name;
-
-        if method_exists(this, setter) || checkVars && property_exists(this, name) {
+        if has_setter(this, name) || checkVars && property_exists(this, name) {
             return true;
         }
 
         if checkBehaviors {
+            var behavior, behaviors;
             this->ensureBehaviors();
-            var behavior;
-            for behavior in this->_behaviors {
-                if behavior->canSetProperty(name, checkVars) {
-                    return true;
+            if checkVars {
+                return component_writable_provider(behavior, this, name);
+            }
+            if component_behaviors(behaviors, this) {
+                for behavior in behaviors {
+                    if behavior->canSetProperty(name, checkVars) {
+                        return true;
+                    }
                 }
             }
         }
@@ -434,13 +427,9 @@ class Component extends $Object
         } 
 
         if checkBehaviors {
-            this->ensureBehaviors();
             var behavior;
-            for behavior in this->_behaviors {
-                if behavior->hasMethod(name) {
-                    return true;
-                }
-            }
+            this->ensureBehaviors();
+            return component_method_provider(behavior, this, name);
         }
 
         return false;
@@ -469,6 +458,8 @@ class Component extends $Object
      * (however, the behaviors can still respond to the component's events).
      *
      * Behaviors declared in this method will be attached to the component automatically (on demand).
+     * Declarations made of scalars and arrays only are read once per class, they should not depend on the state
+     * of the component; declarations holding objects, such as closures, are read for each component.
      *
      * @return array the behavior configurations.
      */
@@ -484,8 +475,12 @@ class Component extends $Object
      */
     public function hasEventHandlers(string name)
     {
+        if !component_listened(this, name) {
+            return false;
+        }
+
         this->ensureBehaviors();
-        if isset this->_events[name] && !empty this->_events[name] {
+        if component_has_handlers(this, name) {
             return true;
         }
         else {
@@ -527,45 +522,7 @@ class Component extends $Object
     {
         this->ensureBehaviors();
 
-        var events, event;
-
-        let events = this->_events;
-        if typeof events != "array" {
-            let events = [];
-        }
-
-        var elements = [];
-        let elements[] = handler,
-            elements[] = data;
-
-        if append == true || !isset events[name] || empty events[name] {
-            if isset events[name] {
-                let event = events[name];
-            }
-            else {
-                let event = [];
-            }
-            if typeof event != "array" {
-                let event = [];
-            }
-            let event[] = elements,
-                events[name] = event;
-        } else {
-            if isset events[name] {
-                let event = events[name];
-            }
-            else {
-                let event = [];
-            }
-            
-            if typeof event != "array" {
-                let event = [];
-            }
-            array_unshift(event, elements);
-            let events[name] = event;
-        }
-
-        let this->_events = events;
+        component_on(this, name, handler, data, append);
     }
 
     /**
@@ -579,44 +536,9 @@ class Component extends $Object
      */
     public function off(string name, handler = null)
     {
-        var removed, events, temp_event, removed_temp_event;
-
         this->ensureBehaviors();
 
-        if !isset this->_events[name] || empty this->_events[name] {
-            return false;
-        }
-
-        let events = this->_events;
-
-        if typeof handler == "null" {
-            if isset events[name] {
-                unset events[name];
-            }
-            let this->_events = events;
-            return true;
-        } else {
-            let removed = false;
-            var i, event;
-            for i, event in this->_events[name] {
-                if event[0] == handler {
-                    let temp_event = events[name];
-                    unset temp_event[i];
-
-                    let events[name] = temp_event,
-                        removed = true;
-                }
-            }
-
-            if (removed) {
-                let removed_temp_event = events[name],
-                    removed_temp_event = array_values(removed_temp_event),
-                    events[name] = removed_temp_event,
-                    this->_events = events;
-            }
-
-            return removed;
-        }
+        return component_off(this, name, handler);
     }
 
     /**
@@ -628,15 +550,16 @@ class Component extends $Object
      */
     public function trigger(string name, event = null)
     {
+        // nothing listens to the event, neither this component nor any class
+        if !component_listened(this, name) {
+            return;
+        }
+
         this->ensureBehaviors();
 
-        var events, temp_event = null;
-        let events = this->_events;
-        if typeof events != "array" {
-            let events = [];
-        }
-        
-        if isset events[name] && !empty events[name] {
+        var temp_event = null;
+
+        if component_has_handlers(this, name) {
             if typeof event == "null" {
                 let temp_event = new Event;
             }
@@ -651,20 +574,9 @@ class Component extends $Object
             let temp_event->handled = false;
             let temp_event->name = name;
 
-            var handler, data, call;
-            for handler in events[name] {
-                if typeof handler == "array" && count(handler) == 2{
-                    let data = handler[1],
-                        call = handler[0];
-
-                    let temp_event->data = data;
-                    call_user_func(call, temp_event);
-                    // stop further handling if the event is handled
-                    if temp_event->handled == true {
-                        return;
-                    }
-                }
-                
+            // the handlers get the event with their own data, and stop once it is handled
+            if component_trigger(this, name, temp_event) {
+                return;
             }
         }
         // invoke class-level attached handlers
@@ -678,9 +590,14 @@ class Component extends $Object
      */
     public function getBehavior(string name)
     {
+        var behavior;
+
         this->ensureBehaviors();
 
-        return isset this->_behaviors[name] ? this->_behaviors[name] : null;
+        if component_behavior(behavior, this, name) {
+            return behavior;
+        }
+        return null;
     }
 
     /**
@@ -689,9 +606,12 @@ class Component extends $Object
      */
     public function getBehaviors()
     {
+        var behaviors;
+
         this->ensureBehaviors();
+        component_behaviors(behaviors, this);
 
-        return this->_behaviors;
+        return behaviors;
     }
 
     /**
@@ -741,13 +661,11 @@ class Component extends $Object
      */
     public function detachBehavior(string name)
     {
-        var behavior, behaviors;
+        var behavior;
         this->ensureBehaviors();
-        let behaviors = this->_behaviors;
 
-        if fetch behavior, behaviors[name] {
-            unset behaviors[name];
-            let this->_behaviors = behaviors;
+        if component_behavior(behavior, this, name) {
+            component_detach(this, name);
             behavior->detach();
             return behavior;
         } else {
@@ -762,7 +680,7 @@ class Component extends $Object
     {
         var name, behavior, behaviors;
         this->ensureBehaviors();
-        let behaviors = this->_behaviors;
+        component_behaviors(behaviors, this);
         for name, behavior in behaviors {
             this->detachBehavior(name);
         }
@@ -773,16 +691,61 @@ class Component extends $Object
      */
     public function ensureBehaviors()
     {
-        if typeof this->_behaviors == "null" {
-            let this->_behaviors = [];
-            
-            var name, behavior;
-            for name, behavior in this->behaviors() {
-                this->attachBehaviorInternal(name, behavior);
+        // a flag test once the behaviors are ensured
+        if component_ensure(this) {
+            var name, behavior, plan;
+            let plan = this->getBehaviorPlan();
+            if !empty plan {
+                for name, behavior in plan {
+                    this->attachBehaviorInternal(name, behavior);
+                }
             }
         }
     }
 
+    /**
+     * Returns the behaviors declared in [[behaviors()]] for the class of this component.
+     * The declarations are cached per class, unless they hold an object at any depth.
+     * @return array the behavior configurations.
+     */
+    protected function getBehaviorPlan()
+    {
+        var $class, plan;
+
+        let $class = get_class(this);
+        if isset self::_behaviorPlans[$class] {
+            return self::_behaviorPlans[$class];
+        }
+
+        let plan = this->behaviors();
+        if typeof plan == "array" && self::isPlainDeclaration(plan) {
+            static_property_array_update("_behaviorPlans", plan, $class);
+        }
+
+        return plan;
+    }
+
+    /**
+     * Returns a value indicating whether a declaration holds nothing but scalars and arrays.
+     * @param array $declaration the behavior declarations or a part of them
+     * @return boolean whether the declaration can be shared by the instances of a class
+     */
+    private static function isPlainDeclaration(array declaration) -> boolean
+    {
+        var value;
+
+        for value in declaration {
+            if typeof value == "object" {
+                return false;
+            }
+            if typeof value == "array" && !self::isPlainDeclaration(value) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     /**
      * Attaches a behavior to this component.
      * @param string $name the name of the behavior.
@@ -791,20 +754,18 @@ class Component extends $Object
      */
     protected function attachBehaviorInternal(string name, behavior)
     {
-        var temp_behavior, behaviors;
+        var temp_behavior;
         if typeof behavior != "object" {
             let behavior = BaseYii::createObject(behavior);
         }
 
-        if fetch temp_behavior, this->_behaviors[name] {
+        if component_behavior(temp_behavior, this, name) {
             temp_behavior->detach();
         }
         
         behavior->attach(this);
 
-        let behaviors = this->_behaviors,
-            behaviors[name] = behavior,
-            this->_behaviors = behaviors;
+        component_attach(this, name, behavior);
         return behavior;
     }
 }
@@ -0,0 +1,20 @@
+/**
+ * @link http://www.yiiframework.com/
+ * @copyright Copyright (c) 2008 Yii Software LLC
+ * @license http://www.yiiframework.com/license/
+ */
+
+namespace yii\base;
+
+/**
+ * ComponentStorageInterface gives a [[Component]] native storage for its event handlers and behaviors.
+ *
+ * The interface is implemented natively (see `fixed/base/componentstorageinterface.c`): the classes implementing it
+ * are created with an object structure holding the event handlers and the behaviors, which [[Component]] reaches
+ * through the `component_*` optimizers instead of the `_events` and `_behaviors` properties.
+ *
+ * @since 2.0
+ */
+interface ComponentStorageInterface
+{
+}
@@ -48,6 +48,21 @@ class Event extends $Object
     public data;
 
     protected static _events;
+    /**
+     * @var integer incremented whenever a class-level handler is attached or detached
+     */
+    protected static _generation = 0;
+    /**
+     * @var array the handlers of each class and its parent classes, in the order they are called
+     * (event name => class name => handlers), valid as long as [[_generation]] is [[_cachedGeneration]]
+     */
+    protected static _cache = [];
+    protected static _cachedGeneration = 0;
+    /**
+     * @var array the number of handlers attached to each event name, by components and by classes.
+     * A name missing from it has no handler anywhere, see [[Component::trigger()]].
+     */
+    protected static _listeners = [];
 
     /**
      * Attaches an event handler to a class-level event.
@@ -77,35 +92,16 @@ class Event extends $Object
      */
     public static function on($class, string name, handler, data = null)
     {
-        var events, elements = [], event, event_class;
+        var elements;
 
         let $class = ltrim($class, "\\");
 
-        let events = self::$_events;
-
-        if typeof events != "array" {
-            let events = [];
-        }
-
-        let elements[] = handler,
-            elements[] = data;
+        let elements = [handler, data];
+        static_property_array_append("_events", elements, name, $class);
+        let self::_generation = self::_generation + 1;
+        event_listen(name, 1);
 
-        if !isset events[name] {
-            let events[name] = [];
-        }
-        let event = events[name];
-        if !isset event[$class] {
-            let event[$class] = [];
-        }
-        
-        let event_class = event[$class],
-            event_class[] = elements,
-            event[$class] = event_class,
-            events[name] = event,
-            self::_events = events;
- 
         return elements;
-       
     }
 
     /**
@@ -122,47 +118,39 @@ class Event extends $Object
      */
     public static function off($class, string name, handler = null)
     {
-        var events, event, temp_event, temp_event2, removed_temp_event;
+        var removed, i, temp_event;
+        int detached;
 
         let $class = ltrim($class, "\\");
         if !isset self::_events[name][$class] || empty self::_events[name][$class] {
             return false;
         }
+
         if typeof handler == "null" {
-            let events = self::_events,
-                event = events[name];
-            unset event[$class];
-            let events[name] = event,
-                self::_events = events;
+            let detached = count(self::_events[name][$class]);
+            event_listen(name, 0 - detached);
+            static_property_array_unset("_events", name, $class);
+            let self::_generation = self::_generation + 1;
             return true;
-        } else {
-            var removed, i;
-            let removed = false;
-            let events = self::_events,
-                event = events[name];
-
-            if isset event[$class] && typeof event[$class] == "array" {
-                for i, temp_event in event[$class] {
-                    if temp_event[0] == handler {
-
-                        let temp_event2 = event[$class];
-                        unset temp_event2[i];
-
-                        let event[$class] = temp_event2,
-                            removed = true;
-                    } 
-                }
-            }
-            if (removed) {
-                let removed_temp_event = event[$class],
-                    removed_temp_event = array_values(removed_temp_event),
-                    event[$class] = removed_temp_event,
-                    events[name] = event[$class],
-                    self::_events = events;
+        }
+
+        let removed = false,
+            detached = 0;
+        for i, temp_event in self::_events[name][$class] {
+            if temp_event[0] == handler {
+                static_property_array_unset("_events", name, $class, i);
+                let removed = true;
+                let detached++;
             }
+        }
 
-            return removed;
+        if removed {
+            event_listen(name, 0 - detached);
+            static_property_array_update("_events", array_values(self::_events[name][$class]), name, $class);
+            let self::_generation = self::_generation + 1;
         }
+
+        return removed;
     }
 
     /**
@@ -181,17 +169,9 @@ class Event extends $Object
 
         if typeof $class == "object" {
             let $class = get_class($class);
-        } else {
-            let $class = ltrim($class, "\\");
         }
 
-        while typeof $class != "boolean" {
-            if isset self::_events[name][$class] && !empty self::_events[name][$class] {
-                return true;
-            }
-            let $class = get_parent_class($class);
-        }
-        return false;
+        return !empty self::getClassHandlers($class, name);
     }
 
     /**
@@ -204,10 +184,9 @@ class Event extends $Object
      */
     public static function trigger($class, string name, event = null)
     {
-        var events;
-        let events = self::_events;
+        var handlers;
 
-        if !isset events[name] || empty events[name]{
+        if !isset self::_events[name] || empty self::_events[name] {
             return;
         }
 
@@ -225,27 +204,52 @@ class Event extends $Object
                 let temp_event->sender = $class;
             }
             let $class = get_class($class);
-        } else {
-            let $class = ltrim($class, "\\");
         }
 
-        while typeof $class != "boolean" {
-            if isset events[name][$class] && !empty events[name][$class] {
-                var handler, data, call, class_handers;
-                let class_handers = events[name][$class];
-
-                for handler in class_handers {
-                    let data = handler[1],
-                        call = handler[0];
-
-                    let temp_event->data = data;
-                    call_user_func(call, temp_event);
-                    if temp_event->handled == true {
-                        return;
-                    }
-                }
+        let handlers = self::getClassHandlers($class, name);
+
+        var handler;
+        for handler in handlers {
+            let temp_event->data = handler[1];
+            call_user_func(handler[0], temp_event);
+            if temp_event->handled == true {
+                return;
+            }
+        }
+    }
+
+    /**
+     * Returns the handlers attached to a class-level event for a class and all its parent classes,
+     * in the order they are to be called.
+     * The lists are cached per event and class until a class-level handler is attached or detached.
+     * @param string $class the class name, as given to [[hasHandlers()]] or [[trigger()]].
+     * @param string $name the event name.
+     * @return array the handlers, each an array of the handler and its data.
+     */
+    protected static function getClassHandlers(string $class, string name) -> array
+    {
+        var handlers, current;
+
+        if self::_cachedGeneration !== self::_generation {
+            let self::_cache = [],
+                self::_cachedGeneration = self::_generation;
+        }
+
+        if isset self::_cache[name][$class] {
+            return self::_cache[name][$class];
+        }
+
+        let handlers = [],
+            current = ltrim($class, "\\");
+        while typeof current != "boolean" {
+            if isset self::_events[name][current] && !empty self::_events[name][current] {
+                let handlers = array_merge(handlers, self::_events[name][current]);
             }
-            let $class = get_parent_class($class);
+            let current = get_parent_class(current);
         }
+
+        static_property_array_update("_cache", handlers, name, $class);
+
+        return handlers;
     }
 }
@@ -127,14 +127,13 @@ class $Object
      */
     public function __get(string name)
     {
-    	var getter, setter;
-        let getter = "get". name,
-        	setter = "set". name;
+        var value;
 
-        if method_exists(this, getter) {
-            return this->{getter}();
+        // getters and setters are looked up in a table built once per class
+        if accessor_get(value, this, name) {
+            return value;
         } else {
-        	if method_exists(this, setter) {
+        	if has_setter(this, name) {
             	throw new InvalidCallException("Getting write-only property: " . get_class(this) . "::" . name);
         	} else {
             	throw new UnknownPropertyException("Getting unknown property: " . get_class(this) . "::" . name);
@@ -155,13 +154,8 @@ class $Object
      */
     public function __set(string name, value)
     {
-    	var getter, setter;
-        let getter = "get". name,
-        	setter = "set". name;
-        if method_exists(this, setter) {
-            this->{setter}(value);
-        } else {
-        	if method_exists(this, getter) {
+        if !accessor_set(this, name, value) {
+        	if has_getter(this, name) {
             	throw new InvalidCallException("Setting read-only property: " . get_class(this) . "::" . name);
         	} else {
             	throw new UnknownPropertyException("Setting unknown property: " . get_class(this) . "::" . name);
@@ -181,10 +175,10 @@ class $Object
      */
     public function __isset(string name)
     {
-    	var getter;
-        let getter = "get" . name;
-        if (method_exists(this, getter)) {
-            return this->{getter}() !== null;
+        var value;
+
+        if accessor_get(value, this, name) {
+            return value !== null;
         } else {
             return false;
         }
@@ -203,14 +197,10 @@ class $Object
      */
     public function __unset(string name)
     {
-    	var getter, setter;
-        let getter = "get". name,
-        	setter = "set". name;
+        var value = null;
 
-        if method_exists(this, setter) {
-            this->{setter}(null);
-        } else {
-        	if method_exists(this, getter) {
+        if !accessor_set(this, name, value) {
+        	if has_getter(this, name) {
             	throw new InvalidCallException("Unsetting read-only property: " . get_class(this) . "::" . name);
         	}
         }
@@ -265,7 +255,7 @@ class $Object
      */
     public function canGetProperty(string name, checkVars = true) -> boolean
     {
-        return method_exists(this, "get" . name) || checkVars && property_exists(this, name);
+        return has_getter(this, name) || checkVars && property_exists(this, name);
     }
 
     /**
@@ -283,7 +273,7 @@ class $Object
      */
     public function canSetProperty(string name, checkVars = true) -> boolean
     {
-        return method_exists(this, "set" . name) || checkVars && property_exists(this, name);
+        return has_setter(this, name) || checkVars && property_exists(this, name);
     }
 
     /**
@@ -0,0 +1,143 @@
+/**
+ * @link http://www.yiiframework.com/
+ * @copyright Copyright (c) 2008 Yii Software LLC
+ * @license http://www.yiiframework.com/license/
+ */
+
+namespace yii\di;
+
+use yii\BaseYii;
+use yii\base\InvalidParamException;
+
+/**
+ * BuildProfiler records how [[Container]] and [[ServiceLocator]] spend their time creating objects.
+ *
+ * For each definition (a class or alias name for the container, a component ID for a locator) it records:
+ *
+ * - `built`: the number of instances created
+ * - `hits`: the number of times a shared instance was returned instead
+ * - `time` and `maxTime`: the cumulative and the longest creation time in seconds, measured with a monotonic
+ *   clock and including the creation of the dependencies
+ * - `memory`: the cumulative memory delta in bytes
+ * - `depth`: the deepest chain of dependencies created along with an instance
+ *
+ * The same profiler may be given to the container and to the locators to see the components and their
+ * dependencies in one report:
+ *
+ * ```php
+ * $profiler = new \yii\di\BuildProfiler;
+ * Yii::$container->setProfiler($profiler);
+ * Yii::$app->setProfiler($profiler);
+ * // ...
+ * $profiler->dump('@runtime/build-profile.php');
+ * ```
+ *
+ * Definitions built often and with a large `time` are candidates for singletons, lazy proxies or prototypes.
+ *
+ * @since 2.0
+ */
+class BuildProfiler
+{
+    /**
+     * @var array the statistics indexed by definition names
+     */
+    private _stats = [];
+    /**
+     * @var integer the number of creations in progress
+     */
+    private _depth = 0;
+    /**
+     * @var integer the deepest level reached by the creation in progress
+     */
+    private _reached = 0;
+
+    /**
+     * Marks the beginning of a creation.
+     * @return array the frame to pass to [[end()]]
+     */
+    public function begin() -> array
+    {
+        var frame;
+
+        let this->_depth++;
+        let frame = [monotonic_time(), memory_get_usage(), this->_reached];
+        let this->_reached = this->_depth;
+
+        return frame;
+    }
+
+    /**
+     * Marks the end of a creation and records it.
+     * @param string $name the definition name
+     * @param array $frame the frame returned by [[begin()]]
+     * @param boolean $built whether an instance was created, as opposed to a shared instance being returned
+     */
+    public function end(string name, array frame, boolean built) -> void
+    {
+        var stat;
+        double elapsed;
+        int depth;
+
+        let elapsed = monotonic_time() - frame[0],
+            depth = this->_reached - this->_depth;
+
+        let this->_depth--;
+        if frame[2] > this->_reached {
+            let this->_reached = frame[2];
+        }
+
+        if !fetch stat, this->_stats[name] {
+            let stat = ["built": 0, "hits": 0, "time": 0.0, "maxTime": 0.0, "memory": 0, "depth": 0];
+        }
+
+        if built {
+            let stat["built"] = stat["built"] + 1,
+                stat["time"] = stat["time"] + elapsed,
+                stat["memory"] = stat["memory"] + memory_get_usage() - frame[1];
+            if elapsed > stat["maxTime"] {
+                let stat["maxTime"] = elapsed;
+            }
+            if depth > stat["depth"] {
+                let stat["depth"] = depth;
+            }
+        } else {
+            let stat["hits"] = stat["hits"] + 1;
+        }
+
+        let this->_stats[name] = stat;
+    }
+
+    /**
+     * Returns the recorded statistics.
+     * @return array the statistics indexed by definition names, see the class description for the entries
+     */
+    public function getStats() -> array
+    {
+        return this->_stats;
+    }
+
+    /**
+     * Clears the recorded statistics.
+     */
+    public function reset() -> void
+    {
+        let this->_stats = [],
+            this->_depth = 0,
+            this->_reached = 0;
+    }
+
+    /**
+     * Writes the recorded statistics to a PHP file returning them as an array.
+     * @param string $file the file path or alias
+     * @throws InvalidParamException if the file cannot be written
+     */
+    public function dump(string file) -> void
+    {
+        var path;
+
+        let path = BaseYii::getAlias(file);
+        if file_put_contents(path, "<?php\nreturn " . var_export(this->_stats, true) . ";\n", LOCK_EX) === false {
+            throw new InvalidParamException("Unable to write the build profile to \"" . path . "\".");
+        }
+    }
+}
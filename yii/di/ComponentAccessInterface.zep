@@ -0,0 +1,20 @@
+/**
+ * @link http://www.yiiframework.com/
+ * @copyright Copyright (c) 2008 Yii Software LLC
+ * @license http://www.yiiframework.com/license/
+ */
+
+namespace yii\di;
+
+/**
+ * ComponentAccessInterface gives a [[ServiceLocator]] native object handlers for reading its components as properties.
+ *
+ * The interface is implemented natively (see `fixed/di/componentaccessinterface.c`): the classes implementing it
+ * resolve `$locator->id` straight from the component and definition tables, without calling `__get()`.
+ * Declared properties, dynamic properties and getters keep working as before.
+ *
+ * @since 2.0
+ */
+interface ComponentAccessInterface
+{
+}
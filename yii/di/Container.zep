@@ -9,6 +9,7 @@ namespace yii\di;
 use ReflectionClass;
 use yii\base\Component;
 use yii\base\InvalidConfigException;
+use yii\base\InvalidParamException;
 
 /**
  * Container implements a [dependency injection](http://en.wikipedia.org/wiki/Dependency_injection) container.
@@ -95,10 +96,37 @@ use yii\base\InvalidConfigException;
 class Container 
 //extends Component
 {
+    /**
+     * A new object is created each time the class is requested. This is the lifetime of [[set()]].
+     */
+    const SCOPE_TRANSIENT = "transient";
+    /**
+     * One object is shared for as long as the definition is registered. This is the lifetime of [[setSingleton()]].
+     */
+    const SCOPE_SINGLETON = "singleton";
+    /**
+     * One object is shared for the whole life of the worker process, until `resetScope('worker')` is called.
+     */
+    const SCOPE_WORKER = "worker";
+    /**
+     * One object is shared until `resetScope('request')` is called, usually between two requests.
+     */
+    const SCOPE_REQUEST = "request";
+
     /**
      * @var array singleton objects indexed by their types
      */
     private _singletons;
+    /**
+     * @var array the scopes ([[SCOPE_WORKER]] or [[SCOPE_REQUEST]]) of the shared objects registered via
+     * [[setScoped()]], indexed by their types. Their instances are kept in [[_singletons]].
+     */
+    private _lifetimes;
+    /**
+     * @var array prototype objects indexed by the types registered via [[setPrototype()]]. A type holds null
+     * until its first instance is created, and false while it is being created.
+     */
+    private _prototypes;
     /**
      * @var array object definitions indexed by their types
      */
@@ -108,7 +136,8 @@ class Container
      */
     private _params;
     /**
-     * @var array cached ReflectionClass objects indexed by class/interface names
+     * @var array cached ReflectionClass objects indexed by class/interface names. Classes whose constructor
+     * signature is served by the persistent signature cache are associated with their own name instead.
      */
     private _reflections;
     /**
@@ -116,6 +145,25 @@ class Container
      * is associated with a list of constructor parameter types or default values.
      */
     private _dependencies;
+    /**
+     * @var array instantiation plans indexed by class/interface names, compiled by [[freeze()]].
+     * A plan lists the concrete class name, the constructor arguments, whether the configuration is passed
+     * as the last constructor argument, the configuration and whether the arguments hold [[Instance]] references.
+     * Definitions that cannot be compiled are associated with `false`.
+     */
+    private _plans;
+    /**
+     * @var boolean whether [[get()]] creates objects by running compiled plans
+     */
+    private _frozen = false;
+    /**
+     * @var BuildProfiler the profiler recording the creations, see [[setProfiler()]]
+     */
+    private _profiler;
+    /**
+     * @var boolean whether the next call to [[get()]] is made by [[getProfiled()]]
+     */
+    private _profiled = false;
 
 
     /**
@@ -140,28 +188,77 @@ class Container
      */
     public function get(string $class, params = [], config = [])
     {
-        var singletons, singleton, definitions;
-        let singletons = this->_singletons;
-        if typeof singletons != "array" {
+        var singleton;
+
+        if typeof this->_profiler == "object" {
+            if !this->_profiled {
+                return this->getProfiled($class, params, config);
+            }
+            let this->_profiled = false;
+        }
+
+        // keep no local copies: they would force a full separation on the next update
+        if typeof this->_singletons != "array" {
             let this->_singletons = [];
         }
 
-        let definitions = this->_definitions;
-        if typeof definitions != "array" {
+        if typeof this->_definitions != "array" {
             let this->_definitions = [];
         }
 
         if fetch singleton, this->_singletons[$class] {
-            // singleton
-            return singleton;
+            // a registered singleton holds null until it is instantiated
+            if typeof singleton == "object" {
+                return singleton;
+            }
         }
-        else {
-            if !isset this->_definitions[$class] {
-                return this->build($class, params, config);
+
+        var definition, $object, plan, prototype, exception;
+
+        if fetch prototype, this->_prototypes[$class] {
+            if empty params && empty config {
+                if typeof prototype == "object" {
+                    let $object = clone prototype;
+                    if method_exists($object, "init") {
+                        $object->init();
+                    }
+                    return $object;
+                }
+
+                if typeof prototype == "null" {
+                    let this->_prototypes[$class] = false;
+                    if !call_method_catch($object, exception, this, "get", [$class]) {
+                        // the next get() tries to build the prototype again
+                        let this->_prototypes[$class] = null;
+                        rethrow(exception);
+                        return null;
+                    }
+                    // keep a copy taken before the object is handed out, so that changes made by the caller do not leak into the clones
+                    let this->_prototypes[$class] = clone $object;
+                    return $object;
+                }
             }
         }
 
-        var definition, $object;
+        if this->_frozen {
+            if !fetch plan, this->_plans[$class] {
+                let plan = this->compilePlan($class);
+                let this->_plans[$class] = plan;
+            }
+
+            if plan !== false {
+                let $object = this->runPlan(plan, params, config);
+                if array_key_exists($class, this->_singletons) {
+                    let this->_singletons[$class] = $object;
+                }
+                return $object;
+            }
+        }
+
+        if !isset this->_definitions[$class] {
+            return this->build($class, params, config);
+        }
+
         let definition = this->_definitions[$class];
 
         if is_callable(definition, true) {
@@ -203,6 +300,172 @@ class Container
         return $object;
     }
 
+    /**
+     * Returns new instances of the requested class, one for each of the given configurations.
+     *
+     * This is the bulk version of [[get()]] for creating many objects of the same type, e.g. when hydrating
+     * a result set. The definition is looked up, the constructor parameters merged and the dependencies resolved
+     * only once: the resolved dependencies are shared by all the created objects. Only the configuration differs
+     * from one object to the other.
+     *
+     * ```php
+     * $users = $container->getMany('app\models\User', $rows);
+     * ```
+     *
+     * Shared names (see [[setSingleton()]] and [[setScoped()]]) and definitions that cannot be compiled into an
+     * instantiation plan (e.g. callables) are served by calling [[get()]] for each configuration.
+     *
+     * @param string $class the class name or an alias name previously registered via [[set()]]
+     * @param array $configs the lists of name-value pairs used to initialize the properties of each object.
+     * The keys are preserved in the returned array.
+     * @param array $params a list of constructor parameter values, see [[get()]]
+     * @param array $config name-value pairs applied to every object before its own configuration
+     * @return array the created objects, indexed like `$configs`
+     * @throws InvalidConfigException if the class cannot be recognized or correspond to an invalid definition
+     */
+    public function getMany(string $class, array configs, array params = [], array config = []) -> array
+    {
+        var plan, args, base, properties, index, param, key, item, last, $object, objects = [];
+        boolean isObject;
+
+        if typeof this->_singletons != "array" {
+            let this->_singletons = [];
+        }
+
+        if typeof this->_definitions != "array" {
+            let this->_definitions = [];
+        }
+
+        if array_key_exists($class, this->_singletons) {
+            let plan = false;
+        } else {
+            // plans are dropped whenever a definition changes, caching them is safe even if the container is not frozen
+            if !fetch plan, this->_plans[$class] {
+                let plan = this->compilePlan($class);
+                let this->_plans[$class] = plan;
+            }
+        }
+
+        if plan === false {
+            for key, item in configs {
+                if !empty config {
+                    let item = array_merge(config, item);
+                }
+                let objects[key] = this->get($class, params, item);
+            }
+            return objects;
+        }
+
+        let args = plan[1],
+            base = plan[3];
+
+        if !empty params {
+            for index, param in params {
+                let args[index] = param;
+            }
+        }
+
+        if plan[4] || !empty params {
+            let args = this->resolveDependencies(args, plan[0]);
+        }
+
+        if !empty config {
+            let base = array_merge(base, config);
+        }
+
+        let isObject = plan[2] && !empty args;
+        if isObject {
+            let last = count(args) - 1;
+        }
+
+        for key, item in configs {
+            if typeof item != "array" {
+                throw new InvalidConfigException("The configuration of each object must be an array, " . gettype(item) . " given.");
+            }
+
+            if empty item {
+                let properties = base;
+            } else {
+                if empty base {
+                    let properties = item;
+                } else {
+                    let properties = array_merge(base, item);
+                }
+            }
+
+            if isObject {
+                // the configuration is passed as the last constructor parameter
+                let args[last] = properties;
+                let properties = null;
+            }
+
+            let $object = create_instance_config(plan[0], args, properties);
+            let objects[key] = $object;
+        }
+
+        return objects;
+    }
+
+    /**
+     * Sets the profiler recording the creations made by [[get()]].
+     * @param BuildProfiler|boolean|null $profiler the profiler, true to create one, false or null to stop profiling
+     * @return static the container itself
+     */
+    public function setProfiler(profiler)
+    {
+        if profiler === true {
+            let profiler = new BuildProfiler();
+        } else {
+            if profiler === false {
+                let profiler = null;
+            }
+        }
+
+        let this->_profiler = profiler,
+            this->_profiled = false;
+        return this;
+    }
+
+    /**
+     * Returns the profiler recording the creations made by [[get()]].
+     * @return BuildProfiler|null the profiler, null if the creations are not profiled
+     */
+    public function getProfiler()
+    {
+        return this->_profiler;
+    }
+
+    /**
+     * Calls [[get()]] and records the creation with the profiler.
+     * @param string $class the class name or an alias name
+     * @param array $params a list of constructor parameter values
+     * @param array $config a list of name-value pairs that will be used to initialize the object properties
+     * @return object an instance of the requested class
+     */
+    protected function getProfiled(string $class, params, config)
+    {
+        var profiler, frame, singleton, $object, exception;
+        boolean built = true;
+
+        if fetch singleton, this->_singletons[$class] {
+            let built = typeof singleton != "object";
+        }
+
+        let profiler = this->_profiler,
+            frame = profiler->begin();
+
+        let this->_profiled = true;
+        if !call_method_catch($object, exception, this, "get", [$class, params, config]) {
+            // the frame is closed whatever happens, or the depths of the later records would be off
+            profiler->end($class, frame, false);
+            rethrow(exception);
+            return null;
+        }
+
+        profiler->end($class, frame, built);
+        return $object;
+    }
+
     /**
      * Registers a class definition with this container.
      *
@@ -270,6 +533,9 @@ class Container
         let this->_definitions[$class] = this->normalizeDefinition($class, definition);
         let this->_params[$class] = params;
         unset this->_singletons[$class];
+        unset this->_lifetimes[$class];
+        unset this->_prototypes[$class];
+        let this->_plans = [];
         return this;
     }
 
@@ -291,6 +557,158 @@ class Container
         let this->_definitions[$class] = this->normalizeDefinition($class, definition);
         let this->_params[$class] = params;
         let this->_singletons[$class] = null;
+        unset this->_lifetimes[$class];
+        unset this->_prototypes[$class];
+        let this->_plans = [];
+        return this;
+    }
+
+    /**
+     * Registers a class definition with this container and shares its instance within the given scope.
+     *
+     * This method is similar to [[setSingleton()]] except that the shared instance can be dropped by [[resetScope()]],
+     * so that long-running workers may keep expensive objects (e.g. database connections) across requests while
+     * recreating the ones holding request state:
+     *
+     * ```php
+     * $container->setScoped('db', Container::SCOPE_WORKER, ['class' => 'yii\db\Connection', 'dsn' => '...']);
+     * $container->setScoped('user', Container::SCOPE_REQUEST, 'app\components\User');
+     *
+     * // between two requests
+     * $container->resetScope(Container::SCOPE_REQUEST);
+     * ```
+     *
+     * An object should not depend on an object with a shorter lifetime: the dependency injected
+     * in it would outlive its scope.
+     *
+     * @param string $class class name, interface name or alias name
+     * @param string $scope the lifetime of the instance. Transient and singleton scopes are registered
+     * via [[set()]] and [[setSingleton()]] respectively.
+     * @param mixed $definition the definition associated with `$class`. See [[set()]] for more details.
+     * @param array $params the list of constructor parameters. The parameters will be passed to the class
+     * constructor when [[get()]] is called.
+     * @return static the container itself
+     * @throws InvalidParamException if the scope is unknown
+     */
+    public function setScoped(string $class, string scope, var definition = [], array params = [])
+    {
+        if scope == self::SCOPE_TRANSIENT {
+            return this->set($class, definition, params);
+        }
+
+        if scope == self::SCOPE_SINGLETON {
+            return this->setSingleton($class, definition, params);
+        }
+
+        if scope != self::SCOPE_WORKER && scope != self::SCOPE_REQUEST {
+            throw new InvalidParamException("Unknown scope \"" . scope . "\".");
+        }
+
+        this->setSingleton($class, definition, params);
+        let this->_lifetimes[$class] = scope;
+        return this;
+    }
+
+    /**
+     * Registers a class definition with this container and creates its instances by cloning a prototype.
+     *
+     * The first instance is built and configured as with [[set()]]. A copy of it is kept as the prototype,
+     * and each later call to [[get()]] without constructor parameters nor configuration returns a shallow
+     * clone of the prototype on which `init()` is called. This skips the dependency resolution and the
+     * property configuration, which is worth it for definitions with a large static configuration.
+     *
+     * The cloned objects share the objects referenced by the prototype's properties. The configuration may
+     * not attach event handlers or behaviors (`on ...` and `as ...` keys), as [[\yii\base\Component::__clone()]]
+     * drops them from the clones.
+     *
+     * @param string $class class name, interface name or alias name
+     * @param mixed $definition the definition associated with `$class`. See [[set()]] for more details.
+     * @param array $params the list of constructor parameters. The parameters will be passed to the class
+     * constructor when the prototype is created.
+     * @return static the container itself
+     * @throws InvalidConfigException if the definition attaches event handlers or behaviors
+     */
+    public function setPrototype(string $class, var definition = [], array params = [])
+    {
+        var name;
+
+        // a rejected definition leaves the current registration of the class untouched
+        let definition = this->normalizeDefinition($class, definition);
+        if typeof definition == "array" {
+            for name in array_keys(definition) {
+                if typeof name == "string" && (strncmp(name, "on ", 3) === 0 || strncmp(name, "as ", 3) === 0) {
+                    throw new InvalidConfigException("The prototype definition of \"" . $class . "\" cannot contain \"" . name . "\": event handlers and behaviors are not cloned.");
+                }
+            }
+        }
+
+        this->set($class, definition, params);
+        let this->_prototypes[$class] = null;
+        return this;
+    }
+
+    /**
+     * Drops the prototype of a class registered via [[setPrototype()]], the next [[get()]] builds a new one.
+     * @param string $class class name, interface name or alias name
+     * @return static the container itself
+     */
+    public function resetPrototype(string $class)
+    {
+        if typeof this->_prototypes == "array" && array_key_exists($class, this->_prototypes) {
+            let this->_prototypes[$class] = null;
+        }
+        return this;
+    }
+
+    /**
+     * Returns the lifetime of the objects created for the given name.
+     * @param string $class class name, interface name or alias name
+     * @return string one of the `SCOPE_*` constants
+     */
+    public function getScope(string $class) -> string
+    {
+        var scope;
+
+        if fetch scope, this->_lifetimes[$class] {
+            return scope;
+        }
+
+        if typeof this->_singletons == "array" && array_key_exists($class, this->_singletons) {
+            return self::SCOPE_SINGLETON;
+        }
+
+        return self::SCOPE_TRANSIENT;
+    }
+
+    /**
+     * Drops the shared instances of a scope.
+     *
+     * The definitions are kept: the next [[get()]] creates a new instance, which is shared until the scope
+     * is reset again. Every name registered via [[setScoped()]] is checked, and only the instances of the given
+     * scope are dropped; singletons and the instances of the other scope are left untouched.
+     *
+     * @param string $scope the scope to reset, [[SCOPE_REQUEST]] or [[SCOPE_WORKER]]
+     * @return static the container itself
+     * @throws InvalidParamException if the scope cannot be reset
+     */
+    public function resetScope(string scope)
+    {
+        var $class, lifetime;
+
+        if scope != self::SCOPE_WORKER && scope != self::SCOPE_REQUEST {
+            throw new InvalidParamException("Only the \"" . self::SCOPE_WORKER . "\" and \"" . self::SCOPE_REQUEST . "\" scopes can be reset, \"" . scope . "\" given.");
+        }
+
+        if typeof this->_lifetimes != "array" {
+            return this;
+        }
+
+        for $class, lifetime in this->_lifetimes {
+            if lifetime == scope {
+                let this->_singletons[$class] = null;
+            }
+        }
+
         return this;
     }
 
@@ -325,6 +743,52 @@ class Container
     {
         unset this->_definitions[$class];
         unset this->_singletons[$class];
+        unset this->_lifetimes[$class];
+        unset this->_prototypes[$class];
+        let this->_plans = [];
+    }
+
+    /**
+     * Compiles every registered definition into an instantiation plan.
+     *
+     * Once the container is frozen, [[get()]] creates objects by running these plans: the chain of aliases,
+     * the constructor parameters, the configuration and the dependencies are resolved when the plan is compiled,
+     * and the object is created by calling its constructor directly. Classes requested without a definition are
+     * compiled on their first use. Definitions that cannot be compiled (callables, shared objects, classes that
+     * cannot be instantiated directly) keep being handled as before.
+     *
+     * Registering or removing a definition drops the compiled plans, they are compiled again when needed.
+     *
+     * @return static the container itself
+     */
+    public function freeze()
+    {
+        var name;
+
+        if typeof this->_singletons != "array" {
+            let this->_singletons = [];
+        }
+
+        if typeof this->_definitions != "array" {
+            let this->_definitions = [];
+        }
+
+        let this->_plans = [];
+        for name in array_keys(this->_definitions) {
+            let this->_plans[name] = this->compilePlan(name);
+        }
+
+        let this->_frozen = true;
+        return this;
+    }
+
+    /**
+     * Returns a value indicating whether the container has been frozen by [[freeze()]].
+     * @return boolean whether objects are created by running compiled plans
+     */
+    public function isFrozen() -> boolean
+    {
+        return this->_frozen;
     }
 
     /**
@@ -408,11 +872,18 @@ class Container
                 let dependencies[i] = config;
             }
             let dependencies = this->resolveDependencies(dependencies, reflection);
+            if typeof reflection == "string" {
+                return create_instance_params(reflection, dependencies);
+            }
             return reflection->newInstanceArgs(dependencies);
         } else {
             var $object;
             let dependencies = this->resolveDependencies(dependencies, reflection);
-            let $object = reflection->newInstanceArgs(dependencies);
+            if typeof reflection == "string" {
+                let $object = create_instance_params(reflection, dependencies);
+            } else {
+                let $object = reflection->newInstanceArgs(dependencies);
+            }
             var name, value;
             for name , value in config {
                 let $object->{name} = value;
@@ -421,6 +892,112 @@ class Container
         }
     }
 
+    /**
+     * Compiles the definition of a class into an instantiation plan.
+     * @param string $class class name, interface name or alias name
+     * @return array|boolean the instantiation plan, or false if the definition cannot be compiled
+     */
+    protected function compilePlan(string $class)
+    {
+        var name, concrete, definition, config, params, elements, dependencies, index, param, hasReferences;
+
+        let name = $class,
+            params = [],
+            config = [];
+
+        // follow the aliases as get() does, merging the configurations and the parameters on the way
+        loop {
+            if !fetch definition, this->_definitions[name] {
+                break;
+            }
+
+            if typeof definition != "array" || is_callable(definition, true) {
+                return false;
+            }
+
+            let concrete = definition["class"];
+            unset definition["class"];
+
+            let config = array_merge(definition, config);
+            let params = this->mergeParams(name, params);
+
+            if concrete === name {
+                break;
+            }
+
+            // a shared instance further down the chain must be returned as is
+            if array_key_exists(concrete, this->_singletons) {
+                return false;
+            }
+
+            let name = concrete;
+        }
+
+        if !class_exists(name) {
+            return false;
+        }
+
+        let elements = this->getDependencies(name);
+        if typeof elements[0] != "string" {
+            // the constructor signature is not cached, the class is instantiated through reflection
+            return false;
+        }
+
+        let dependencies = elements[1];
+        for index, param in params {
+            let dependencies[index] = param;
+        }
+
+        let hasReferences = false;
+        for param in dependencies {
+            if typeof param == "object" && (param instanceof Instance) {
+                let hasReferences = true;
+                break;
+            }
+        }
+
+        return [name, dependencies, is_a(name, "yii\\base\\Object", true), config, hasReferences];
+    }
+
+    /**
+     * Creates an object by running an instantiation plan compiled by [[compilePlan()]].
+     * @param array $plan the instantiation plan
+     * @param array $params constructor parameters, overriding the compiled ones
+     * @param array $config configurations to be applied to the new instance, merged with the compiled ones
+     * @return object the newly created instance
+     */
+    protected function runPlan(plan, params, config)
+    {
+        var args, properties, index, param, i, $object;
+
+        let args = plan[1],
+            properties = plan[3];
+
+        if !empty params {
+            for index, param in params {
+                let args[index] = param;
+            }
+        }
+
+        if !empty config {
+            let properties = array_merge(properties, config);
+        }
+
+        if plan[2] && !empty args {
+            // set the configuration as the last parameter (existing one will be overwritten)
+            let i = count(args) - 1;
+            let args[i] = properties;
+            let properties = null;
+        }
+
+        if plan[4] || !empty params {
+            let args = this->resolveDependencies(args, plan[0]);
+        }
+
+        let $object = create_instance_config(plan[0], args, properties);
+        return $object;
+    }
+
     /**
      * Merges the user-specified constructor parameters with the ones registered via [[set()]].
      * @param string $class class name, interface name or alias name
@@ -447,8 +1024,13 @@ class Container
 
     /**
      * Returns the dependencies of the specified class.
+     *
+     * The constructor signature is taken from a cache kept in persistent memory across requests,
+     * the class is only reflected on when its signature cannot be cached (e.g. non-public constructor).
+     *
      * @param string $class class name, interface name or alias name
-     * @return array the dependencies of the specified class.
+     * @return array the class reflection (or the class name when the signature is cached) and the dependencies
+     * of the specified class.
      */
     protected function getDependencies(string $class)
     {
@@ -457,7 +1039,25 @@ class Container
             return [r,  this->_dependencies[$class]];
         }
 
-        var dependencies = [], reflection, constructor;
+        var dependencies = [], reflection, constructor, signature, entry;
+
+        let signature = constructor_signature($class);
+        if typeof signature == "array" {
+            for entry in signature {
+                // [name, hasDefault, default, className]
+                if entry[1] {
+                    let dependencies[] = entry[2];
+                } else {
+                    let dependencies[] = Instance::of(entry[3]);
+                }
+            }
+
+            let this->_reflections[$class] = $class;
+            let this->_dependencies[$class] = dependencies;
+
+            return [$class, dependencies];
+        }
+
         let reflection = new \ReflectionClass($class);
 
         let constructor = reflection->getConstructor();
@@ -488,7 +1088,7 @@ class Container
     /**
      * Resolves dependencies by replacing them with the actual object instances.
      * @param array $dependencies the dependencies
-     * @param ReflectionClass $reflection the class reflection associated with the dependencies
+     * @param ReflectionClass|string $reflection the class reflection, or the name of the class, associated with the dependencies
      * @return array the resolved dependencies
      * @throws InvalidConfigException if a dependency cannot be resolved or if a dependency cannot be fulfilled.
      */
@@ -502,6 +1102,9 @@ class Container
                 }
                 else {
                     if typeof reflection !== "null" {
+                        if typeof reflection == "string" {
+                            let reflection = new \ReflectionClass(reflection);
+                        }
                         var name, $class;
                         let name = reflection->getConstructor()->getParameters()[index]->getName();
                         let $class = reflection->getName();
@@ -0,0 +1,54 @@
+/**
+ * @link http://www.yiiframework.com/
+ * @copyright Copyright (c) 2008 Yii Software LLC
+ * @license http://www.yiiframework.com/license/
+ */
+
+namespace yii\di;
+
+/**
+ * LazyProxy stands in for a component of a [[ServiceLocator]] until the component is actually used.
+ *
+ * A locator returns a proxy for the components listed in [[ServiceLocator::lazyComponents]].
+ * The component is created from its definition on the first method call or property access made
+ * through the proxy, and from then on the locator returns the component itself.
+ *
+ * The class is implemented natively (see `fixed/di/lazyproxy.c`): the proxy state lives in the object structure,
+ * and method calls, property and array accesses, casts and cloning are forwarded through object handlers rather
+ * than magic methods, so a built proxy costs a single indirection. This file only declares the methods the native
+ * class provides. A proxy is not an instance of the component class, though; code relying on type checks should
+ * call [[resolve()]] or fetch the component again from the locator.
+ *
+ * @since 2.0
+ */
+final class LazyProxy
+{
+    /**
+     * Creates a proxy for a component of the given locator.
+     * @param ServiceLocator $locator the locator owning the component
+     * @param string $id the component ID
+     * @param string|array $definition the component definition passed to [[BaseYii::createObject()]]
+     * @return LazyProxy the proxy
+     */
+    public static function create(<ServiceLocator> locator, id, definition)
+    {
+    }
+
+    /**
+     * Returns the component behind a proxy, creating it if necessary.
+     * @param mixed $value a proxy or any other value
+     * @return mixed the component if `$value` is a proxy, `$value` itself otherwise
+     */
+    public static function resolve(value)
+    {
+    }
+
+    /**
+     * Returns a value indicating whether the component behind a proxy has been created.
+     * @param LazyProxy $proxy the proxy
+     * @return boolean whether the component has been created
+     */
+    public static function isInitialized(<LazyProxy> proxy)
+    {
+    }
+}
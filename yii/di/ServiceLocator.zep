@@ -46,7 +46,7 @@ use yii\base\InvalidConfigException;
  * @author Qiang Xue <qiang.xue@gmail.com>
  * @since 2.0
  */
-class ServiceLocator extends Component
+class ServiceLocator extends Component implements ComponentAccessInterface
 {
     /**
      * @var array shared component instances indexed by their IDs
@@ -56,10 +56,28 @@ class ServiceLocator extends Component
      * @var array component definitions indexed by their IDs
      */
     public _definitions;
+    /**
+     * @var array IDs of the components that should be created lazily. For these components [[get()]]
+     * returns a [[LazyProxy]] which creates the component on its first method call or property access.
+     * Only components defined by a class name or a configuration array can be made lazy; a proxy does
+     * not pass type checks against the component class, see [[LazyProxy::resolve()]].
+     */
+    public lazyComponents = [];
+    /**
+     * @var BuildProfiler the profiler recording the creations, see [[setProfiler()]]
+     */
+    private _profiler;
+    /**
+     * @var boolean whether the next call to [[get()]] is made by [[getProfiled()]]
+     */
+    private _profiled = false;
 
     /**
      * Getter magic method.
      * This method is overridden to support accessing components like reading properties.
+     *
+     * Reading a component is normally resolved by the native handlers of [[ComponentAccessInterface]] before
+     * this method is reached; it still serves the subclasses that override it and the profiled locators.
      * @param string $name component or property name
      * @return mixed the named property value
      */
@@ -103,14 +121,6 @@ class ServiceLocator extends Component
      */
     public function has(string id, checkInstance = false)
     {
-       var components;
-        let components = this->_components;
-
-        if typeof components != "array" {
-            let components = [],
-                this->_components = components;
-        }
-
         if checkInstance {
             return isset this->_components[id];
         }
@@ -133,34 +143,32 @@ class ServiceLocator extends Component
      */
     public function get(string id, throwException = true)
     {
-        var components, component;
-        let components = this->_components;
+        var component, definition, $object;
 
-        if typeof components != "array" {
-            let components = [],
-                this->_components = components;
+        if typeof this->_profiler == "object" {
+            if !this->_profiled {
+                return this->getProfiled(id, throwException);
+            }
+            let this->_profiled = false;
         }
 
-        if fetch component, components[id] {
+        if fetch component, this->_components[id] {
             return component;
         }
 
-        var definition, copy_definition, copy_object, $object;
         if fetch definition, this->_definitions[id] {
-            let copy_definition = definition;
-            if typeof definition == "object" {
-                if !(definition instanceof \Closure) {
-                    let components[id] = copy_definition,
-                        this->_components = components;
-                    return definition;
-                }
+            if typeof definition == "object" && !(definition instanceof \Closure) {
+                let this->_components[id] = definition;
+                return definition;
+            }
+
+            if this->isLazy(id, definition) {
+                let $object = LazyProxy::create(this, id, definition);
             } else {
-                let $object = BaseYii::createObject(copy_definition),
-                    copy_object= $object,
-                    components[id] = copy_object,
-                    this->_components = components;
-                return $object;
+                let $object = BaseYii::createObject(definition);
             }
+            let this->_components[id] = $object;
+            return $object;
         }
         else {
             if throwException {
@@ -171,6 +179,83 @@ class ServiceLocator extends Component
         }
     }
 
+    /**
+     * Sets the profiler recording the creations of the components made by [[get()]].
+     * @param BuildProfiler|boolean|null $profiler the profiler, true to create one, false or null to stop profiling
+     */
+    public function setProfiler(profiler)
+    {
+        if profiler === true {
+            let profiler = new BuildProfiler();
+        } else {
+            if profiler === false {
+                let profiler = null;
+            }
+        }
+
+        let this->_profiler = profiler,
+            this->_profiled = false;
+    }
+
+    /**
+     * Returns the profiler recording the creations of the components made by [[get()]].
+     * @return BuildProfiler|null the profiler, null if the creations are not profiled
+     */
+    public function getProfiler()
+    {
+        return this->_profiler;
+    }
+
+    /**
+     * Calls [[get()]] and records the creation of the component with the profiler.
+     * @param string $id component ID
+     * @param boolean $throwException whether to throw an exception if `$id` is not registered with the locator before
+     * @return object|null the component of the specified ID
+     */
+    protected function getProfiled(string id, throwException)
+    {
+        var profiler, frame, $object, exception;
+        boolean built;
+
+        let built = !isset this->_components[id];
+        let profiler = this->_profiler,
+            frame = profiler->begin();
+
+        let this->_profiled = true;
+        if !call_method_catch($object, exception, this, "get", [id, throwException]) {
+            // unknown IDs throw too: leave the profiler balanced for the next component
+            profiler->end(id, frame, false);
+            rethrow(exception);
+            return null;
+        }
+
+        profiler->end(id, frame, built);
+        return $object;
+    }
+
+    /**
+     * Returns a value indicating whether the component should be returned as a [[LazyProxy]].
+     * @param string $id component ID
+     * @param mixed $definition the component definition
+     * @return boolean whether the component should be created lazily
+     */
+    protected function isLazy(string id, definition) -> boolean
+    {
+        if typeof this->lazyComponents != "array" || empty this->lazyComponents {
+            return false;
+        }
+
+        if typeof definition != "string" && typeof definition != "array" {
+            return false;
+        }
+
+        if typeof definition == "array" && !isset definition["class"] {
+            return false;
+        }
+
+        return in_array(id, this->lazyComponents, true);
+    }
+
     /**
      * Registers a component definition with this locator.
      *
@@ -216,37 +301,21 @@ class ServiceLocator extends Component
      */
     public function set(string id, definition)
     {
-        var components, definitions;
-        let components = this->_components;
-        let definitions = this->_definitions;
-
-        if typeof components != "array" {
-            let components = [];
-        }
-
-        if typeof definitions != "array" {
-            let definitions = [];
-        }
-
         if typeof definition == "null" {
-            unset components[id];
-            unset definitions[id];
-            let this->_components = components,
-                this->_definitions = definitions;
+            unset this->_components[id];
+            unset this->_definitions[id];
             return;
         }
 
         if typeof definition == "object" || is_callable(definition, true) {
             // an object, a class name, or a PHP callable
-            let definitions[id] = definition,
-                this->_definitions = definitions;
+            let this->_definitions[id] = definition;
         }
         else {
             if typeof definition == "array" {
                 // a configuration array
                 if isset definition["class"] {
-                    let definitions[id] = definition,
-                        this->_definitions = definitions;
+                    let this->_definitions[id] = definition;
                 } else {
                     string text = "class";
                     throw new InvalidConfigException("The configuration for the \"" . id . "\" component must contain a \"" . text ."\" element.");
@@ -274,19 +343,15 @@ class ServiceLocator extends Component
      */
     public function getComponents(bool returnDefinitions = true)
     {
-        var components, definitions;
-        let components = this->_components;
-        let definitions = this->_definitions;
-
-        if typeof components != "array" {
+        if typeof this->_components != "array" {
             let this->_components = [];
         }
 
-        if typeof definitions != "array" {
+        if typeof this->_definitions != "array" {
             let this->_definitions = [];
         }
 
-        return returnDefinitions ? definitions : components;
+        return returnDefinitions ? this->_definitions : this->_components;
     }
 
     /**